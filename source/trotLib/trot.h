@@ -31,6 +31,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef trot_H
 #define trot_H
 
+/******************************************************************************/
+#include <stddef.h> /* for size_t */
+
 /******************************************************************************/
 #define TROT_NAME "Trot"
 
@@ -52,6 +55,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef u8
 #define u8  unsigned char
 #endif
+/* This defines u16 as an unsigned 16-bit integer */
+#ifndef u16
+#define u16 unsigned short
+#endif
 
 /******************************************************************************/
 #define TROT_RC s32
@@ -110,16 +117,49 @@ hardcode TROT_INT to s32 since we're going to be using that everywhere */
 #error NEED TO DEFINE TROT_INT FOR TROT_INT_SIZE
 #endif
 
+/******************************************************************************/
+/* When a program frees lists. TROT_GC_IMMEDIATE frees a list as soon as its
+   last client ref is freed. TROT_GC_DEFERRED leaves lists until
+   trotProgramGcCollect is called, or collects a little at a time with
+   trotProgramGcStep. TROT_GC_CYCLES frees a list as soon as nothing refers
+   to it, and finds lists that only refer to each other now and then. */
+#define TROT_GC_IMMEDIATE 0
+#define TROT_GC_DEFERRED 1
+#define TROT_GC_CYCLES 2
+
 /******************************************************************************/
 typedef struct TrotProgram_STRUCT TrotProgram;
 typedef struct TrotData_STRUCT TrotData;
 
 /******************************************************************************/
-TROT_RC trotProgramLoad( TROT_INT memoryLimit, const char *savedProgram, TrotProgram **program_A );
+/*! An allocator for a program to use instead of the default malloc, calloc,
+realloc and free. context is passed as the first argument of each function. */
+typedef struct
+{
+	/*! Like malloc. */
+	void *(*mallocFunc)( void *context, size_t size );
+	/*! Like calloc. */
+	void *(*callocFunc)( void *context, size_t nmemb, size_t size );
+	/*! Like realloc. Never called with a NULL pointer. */
+	void *(*reallocFunc)( void *context, void *p, size_t size );
+	/*! Like free. */
+	void (*freeFunc)( void *context, void *p );
+	/*! Passed to each function. */
+	void *context;
+} TrotAllocator;
+
+/******************************************************************************/
+TROT_RC trotProgramLoad( TROT_INT memoryLimit, const TrotAllocator *allocator, const char *savedProgram, TrotProgram **program_A );
 
 TROT_RC trotProgramMemoryGetUsed( TrotProgram *program, TROT_INT *used );
 TROT_RC trotProgramMemoryGetLimit( TrotProgram *program, TROT_INT *limit );
 TROT_RC trotProgramMemorySetLimit( TrotProgram *program, TROT_INT limit );
+TROT_RC trotProgramMemoryGetSlabStats( TrotProgram *program, TROT_INT *slabs, TROT_INT *bytes, TROT_INT *objects );
+
+TROT_RC trotProgramGcSetMode( TrotProgram *program, TROT_INT mode );
+TROT_RC trotProgramGcCollect( TrotProgram *program );
+TROT_RC trotProgramGcStep( TrotProgram *program, TROT_INT *finished );
+TROT_RC trotProgramGcSetBudget( TrotProgram *program, TROT_INT budget );
 
 TROT_RC trotProgramCyclesGet( TrotProgram *program, TROT_INT *cycles );
 TROT_RC trotProgramCyclesSet( TrotProgram *program, TROT_INT cycles );
@@ -40,8 +40,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "trotInternal.h"
 
 /******************************************************************************/
-static TROT_RC skipWhitespace( TrotProgram *program, TrotList *lCharacters, TROT_INT charactersCount, TROT_INT *index, s32 mustBeOne );
-static TROT_RC getWord( TrotProgram *program, TrotList *lCharacters, TROT_INT charactersCount, TROT_INT *index, TrotList **lWord_A );
+static TROT_RC skipWhitespace( TrotProgram *program, TrotListCursor *cursor, TROT_INT charactersCount, s32 mustBeOne );
+static TROT_RC getWord( TrotProgram *program, TrotListCursor *cursor, TROT_INT charactersCount, TrotList **lWord_A );
 static TROT_RC wordToNumber( TrotProgram *program, TrotList *lWord, TROT_INT *number );
 static TROT_RC splitList( TrotProgram *program, TrotList *listToSplit, TROT_INT separator, TrotList **lPartList_A );
 static TROT_RC getReferenceList( TrotProgram *program, TrotList *lTop, TrotList *lPartList, TrotList **lReference_A );
@@ -63,7 +63,7 @@ TROT_RC trotDecode( TrotProgram *program, TrotList *lCharacters, TrotList **lDec
 	TROT_RC rc = TROT_RC_SUCCESS;
 
 	TROT_INT charactersCount = 0;
-	TROT_INT index = 1;
+	TrotListCursor cursor;
 
 	TrotList *lTop = NULL;
 	TrotList *lCurrent = NULL;
@@ -105,39 +105,47 @@ TROT_RC trotDecode( TrotProgram *program, TrotList *lCharacters, TrotList **lDec
 	rc = trotListInit( program, &lStack );
 	ERR_IF_PASSTHROUGH;
 
+	/* start at first character */
+	rc = trotListCursorInit( program, lCharacters, &cursor );
+	PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
+
+	rc = trotListCursorNext( program, &cursor );
+	PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 	/* skip whitespace */
-	rc = skipWhitespace( program, lCharacters, charactersCount, &index, 0 );
+	rc = skipWhitespace( program, &cursor, charactersCount, 0 );
 	ERR_IF_PASSTHROUGH;
 
 
 	/* get first character */
-	rc = trotListGetInt( program, lCharacters, index, &ch );
+	rc = trotListCursorGetInt( program, &cursor, &ch );
 	ERR_IF_PASSTHROUGH;
 
 	/* must be [ */
 	ERR_IF_1( ch != '[', TROT_RC_ERROR_DECODE, ch );
 
 	/* skip past [ */
-	index += 1;
+	rc = trotListCursorNext( program, &cursor );
+	PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 
 	/* decode rest of characters */
 	while ( 1 )
 	{
 		/* skip whitespace */
-		rc = skipWhitespace( program, lCharacters, charactersCount, &index, 1 );
+		rc = skipWhitespace( program, &cursor, charactersCount, 1 );
 		ERR_IF_PASSTHROUGH;
 		
 		/* get next character */
-		rc = trotListGetInt( program, lCharacters, index, &ch );
+		rc = trotListCursorGetInt( program, &cursor, &ch );
 		ERR_IF_PASSTHROUGH;
 
 		/* if left bracket, create new child list and "go down" into it */
 		if ( ch == '[' )
 		{
 			/* skip bracket */
-			index += 1;
+			rc = trotListCursorNext( program, &cursor );
+			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 			/* create new list */
 			trotListFree( program, &lChild );
@@ -161,7 +169,8 @@ TROT_RC trotDecode( TrotProgram *program, TrotList *lCharacters, TrotList **lDec
 		else if ( ch == ']' )
 		{
 			/* skip bracket */
-			index += 1;
+			rc = trotListCursorNext( program, &cursor );
+			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 			/* is stack empty? */
 			rc = trotListGetCount( program, lStack, &stackCount );
@@ -181,11 +190,12 @@ TROT_RC trotDecode( TrotProgram *program, TrotList *lCharacters, TrotList **lDec
 		else if ( ch == '~' )
 		{
 			/* skip tilde */
-			index += 1;
+			rc = trotListCursorNext( program, &cursor );
+			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 			/* get word */
 			trotListFree( program, &lWord );
-			rc = getWord( program, lCharacters, charactersCount, &index, &lWord );
+			rc = getWord( program, &cursor, charactersCount, &lWord );
 			ERR_IF_PASSTHROUGH;
 
 			/* word to number */
@@ -200,11 +210,12 @@ TROT_RC trotDecode( TrotProgram *program, TrotList *lCharacters, TrotList **lDec
 		else if ( ch == '`' )
 		{
 			/* skip backtick */
-			index += 1;
+			rc = trotListCursorNext( program, &cursor );
+			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 			/* get word */
 			trotListFree( program, &lWord );
-			rc = getWord( program, lCharacters, charactersCount, &index, &lWord );
+			rc = getWord( program, &cursor, charactersCount, &lWord );
 			ERR_IF_PASSTHROUGH;
 
 			/* word to number */
@@ -220,7 +231,7 @@ TROT_RC trotDecode( TrotProgram *program, TrotList *lCharacters, TrotList **lDec
 		{
 			/* get word */
 			trotListFree( program, &lWord );
-			rc = getWord( program, lCharacters, charactersCount, &index, &lWord );
+			rc = getWord( program, &cursor, charactersCount, &lWord );
 			ERR_IF_PASSTHROUGH;
 
 			/* split */
@@ -242,7 +253,7 @@ TROT_RC trotDecode( TrotProgram *program, TrotList *lCharacters, TrotList **lDec
 		{
 			/* get word */
 			trotListFree( program, &lWord );
-			rc = getWord( program, lCharacters, charactersCount, &index, &lWord );
+			rc = getWord( program, &cursor, charactersCount, &lWord );
 			ERR_IF_PASSTHROUGH;
 
 			/* word to number */
@@ -256,11 +267,11 @@ TROT_RC trotDecode( TrotProgram *program, TrotList *lCharacters, TrotList **lDec
 	}
 
 	/* skip whitespace */
-	rc = skipWhitespace( program, lCharacters, charactersCount, &index, 0 );
+	rc = skipWhitespace( program, &cursor, charactersCount, 0 );
 	ERR_IF_PASSTHROUGH;
 
 	/* we must be at end of characters */
-	ERR_IF( index != (charactersCount + 1), TROT_RC_ERROR_DECODE );
+	ERR_IF( cursor.index != (charactersCount + 1), TROT_RC_ERROR_DECODE );
 
 
 	/* give back */
@@ -285,15 +296,14 @@ TROT_RC trotDecode( TrotProgram *program, TrotList *lCharacters, TrotList **lDec
 /*!
 	\brief Skips whitespace characters.
 	\param[in] program List that maintains memory limit
-	\param[in] lCharacters List of characters.
+	\param[in,out] cursor Cursor into the list of characters.
 	\param[in] charactersCount Count of characters.
-	\param[in,out] index Current index into lCharacters.
 	\param[in] mustBeOne Whether there must be at least 1 whitespace character.
 	\return TROT_RC
 
-	index will be incremented to first non-whitespace character, or 1 past end of list.
+	cursor will be moved to first non-whitespace character, or 1 past end of list.
 */
-static TROT_RC skipWhitespace( TrotProgram *program, TrotList *lCharacters, TROT_INT charactersCount, TROT_INT *index, s32 mustBeOne )
+static TROT_RC skipWhitespace( TrotProgram *program, TrotListCursor *cursor, TROT_INT charactersCount, s32 mustBeOne )
 {
 	/* DATA */
 	TROT_RC rc = TROT_RC_SUCCESS;
@@ -303,24 +313,24 @@ static TROT_RC skipWhitespace( TrotProgram *program, TrotList *lCharacters, TROT
 
 	/* PRECOND */
 	PARANOID_ERR_IF( program == NULL );
-	PARANOID_ERR_IF( lCharacters == NULL );
-	PARANOID_ERR_IF( index == NULL );
+	PARANOID_ERR_IF( cursor == NULL );
 
 
 	/* CODE */
 	if ( mustBeOne )
 	{
-		rc = trotListGetInt( program, lCharacters, (*index), &ch );
+		rc = trotListCursorGetInt( program, cursor, &ch );
 		ERR_IF_PASSTHROUGH;
 
 		ERR_IF( ch != ' ', TROT_RC_ERROR_DECODE );
 
-		(*index) += 1;
+		rc = trotListCursorNext( program, cursor );
+		PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 	}
 
-	while ( (*index) <= charactersCount )
+	while ( cursor->index <= charactersCount )
 	{
-		rc = trotListGetInt( program, lCharacters, (*index), &ch );
+		rc = trotListCursorGetInt( program, cursor, &ch );
 		ERR_IF_PASSTHROUGH;
 
 		if ( ch != ' ' )
@@ -328,7 +338,8 @@ static TROT_RC skipWhitespace( TrotProgram *program, TrotList *lCharacters, TROT
 			break;
 		}
 
-		(*index) += 1;
+		rc = trotListCursorNext( program, cursor );
+		PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 	}
 
 
@@ -342,16 +353,15 @@ static TROT_RC skipWhitespace( TrotProgram *program, TrotList *lCharacters, TROT
 /*!
 	\brief Gets the next word in lCharacters.
 	\param[in] program List that maintains memory limit
-	\param[in] lCharacters List of characters.
+	\param[in,out] cursor Cursor into the list of characters.
 	\param[in] charactersCount Count of characters.
-	\param[in,out] index Current index into lCharacters.
 	\param[out] lWord_A The next word.
 	\return TROT_RC
 
-	index will be incremented.
+	cursor will be moved past the word.
 	lWord_A will be created. Caller is responsible for freeing.
 */
-static TROT_RC getWord( TrotProgram *program, TrotList *lCharacters, TROT_INT charactersCount, TROT_INT *index, TrotList **lWord_A )
+static TROT_RC getWord( TrotProgram *program, TrotListCursor *cursor, TROT_INT charactersCount, TrotList **lWord_A )
 {
 	/* DATA */
 	TROT_RC rc = TROT_RC_SUCCESS;
@@ -362,8 +372,7 @@ static TROT_RC getWord( TrotProgram *program, TrotList *lCharacters, TROT_INT ch
 
 	/* PRECOND */
 	PARANOID_ERR_IF( program == NULL );
-	PARANOID_ERR_IF( lCharacters == NULL );
-	PARANOID_ERR_IF( index == NULL );
+	PARANOID_ERR_IF( cursor == NULL );
 	PARANOID_ERR_IF( lWord_A == NULL );
 	PARANOID_ERR_IF( (*lWord_A) != NULL );
 
@@ -372,9 +381,9 @@ static TROT_RC getWord( TrotProgram *program, TrotList *lCharacters, TROT_INT ch
 	rc = trotListInit( program, &newLWord );
 	ERR_IF_PASSTHROUGH;
 
-	while ( (*index) <= charactersCount )
+	while ( cursor->index <= charactersCount )
 	{
-		rc = trotListGetInt( program, lCharacters, (*index), &ch );
+		rc = trotListCursorGetInt( program, cursor, &ch );
 		ERR_IF_PASSTHROUGH;
 
 		if ( ch == ' ' )
@@ -385,7 +394,8 @@ static TROT_RC getWord( TrotProgram *program, TrotList *lCharacters, TROT_INT ch
 		rc = trotListAppendInt( program, newLWord, ch );
 		ERR_IF_PASSTHROUGH;
 
-		(*index) += 1;
+		rc = trotListCursorNext( program, cursor );
+		PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 	}
 
 
@@ -617,6 +627,7 @@ static TROT_RC splitList( TrotProgram *program, TrotList *listToSplit, TROT_INT
 
 	TROT_INT count = 0;
 	TROT_INT index = 0;
+	TrotListCursor cursor;
 	TROT_INT character = 0;
 
 	TrotList *newLPartList = NULL;
@@ -645,12 +656,18 @@ static TROT_RC splitList( TrotProgram *program, TrotList *listToSplit, TROT_INT
 	rc = trotListGetCount( program, listToSplit, &count );
 	PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
+	rc = trotListCursorInit( program, listToSplit, &cursor );
+	PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
+
 	/* foreach character */
 	index = 1;
 	while ( index <= count )
 	{
 		/* get next character */
-		rc = trotListGetInt( program, listToSplit, index, &character );
+		rc = trotListCursorNext( program, &cursor );
+		PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
+
+		rc = trotListCursorGetInt( program, &cursor, &character );
 		PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 		/* if separator */
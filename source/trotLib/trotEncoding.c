@@ -41,8 +41,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /******************************************************************************/
 static TROT_RC appendLeftBracketAndTags( TrotProgram *program, TrotList *lCharacters, TrotList *l );
-static TROT_RC appendAbsTwinLocation( TrotProgram *program, TrotList *lCharacters, TrotList *l );
+static TROT_RC appendAbsTwinLocation( TrotProgram *program, TrotList *lCharacters, TrotEncodingEntry *table, TrotList *l );
 static TROT_RC appendNumber( TrotProgram *program, TrotList *lCharacters, TROT_INT n );
+static TROT_RC tableAdd( TrotProgram *program, TrotEncodingEntry **table, TROT_INT *tableCount, TROT_INT *tableSize, TrotListActual *la, TROT_INT parent, TROT_INT childNumber );
 
 /******************************************************************************/
 /*!
@@ -68,10 +69,11 @@ TROT_RC trotEncode( TrotProgram *program, TrotList *listToEncode, TrotList **lCh
 	TrotList *lParentIndicesStack = NULL;
 
 	TrotList *lCurrentList = NULL;
+	TrotListCursor cursor;
 
 	TROT_INT type = 0;
 	TROT_INT childrenCount = 0;
-	TROT_INT index = 1;
+	TROT_INT index = 0;
 
 	TROT_INT kind = 0;
 
@@ -79,6 +81,10 @@ TROT_RC trotEncode( TrotProgram *program, TrotList *listToEncode, TrotList **lCh
 
 	TrotList *lChildList = NULL;
 
+	TrotEncodingEntry *table = NULL;
+	TROT_INT tableCount = 0;
+	TROT_INT tableSize = 0;
+
 
 	/* PRECOND */
 	FAILURE_POINT;
@@ -104,16 +110,24 @@ TROT_RC trotEncode( TrotProgram *program, TrotList *listToEncode, TrotList **lCh
 	rc = trotListTwin( program, listToEncode, &lCurrentList );
 	ERR_IF_PASSTHROUGH;
 
-	lCurrentList->laPointsTo->encodingChildNumber = -1;
+	rc = tableAdd( program, &table, &tableCount, &tableSize, lCurrentList->laPointsTo, 0, 0 );
+	ERR_IF_PASSTHROUGH;
 
 	/* start our encoding */
 	rc = appendLeftBracketAndTags( program, newCharacters, lCurrentList );
 	ERR_IF_PASSTHROUGH;
 
+	rc = trotListCursorInit( program, lCurrentList, &cursor );
+	PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
+
 	/* go through list */
 	while ( 1 )
 	{
 		/* do we have a next child? */
+		rc = trotListCursorNext( program, &cursor );
+		PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
+
+		index = cursor.index;
 
 		/* get count */
 		rc = trotListGetCount( program, lCurrentList, &childrenCount );
@@ -148,15 +162,19 @@ TROT_RC trotEncode( TrotProgram *program, TrotList *listToEncode, TrotList **lCh
 			rc = trotListRemoveInt( program, lParentIndicesStack, -1, &index );
 			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
-			/* increment */
-			index += 1;
+			/* pick up where we left off */
+			rc = trotListCursorInit( program, lCurrentList, &cursor );
+			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
+
+			rc = trotListCursorSeek( program, &cursor, index );
+			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 			/* continue */
 			continue;
 		}
 
 		/* get kind */
-		rc = trotListGetKind( program, lCurrentList, index, &kind );
+		rc = trotListCursorGetKind( program, &cursor, &kind );
 		PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 		if ( kind == TROT_KIND_INT )
@@ -166,7 +184,7 @@ TROT_RC trotEncode( TrotProgram *program, TrotList *listToEncode, TrotList **lCh
 			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 			/* get int */
-			rc = trotListGetInt( program, lCurrentList, index, &n );
+			rc = trotListCursorGetInt( program, &cursor, &n );
 			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 			/* append number */
@@ -183,24 +201,24 @@ TROT_RC trotEncode( TrotProgram *program, TrotList *listToEncode, TrotList **lCh
 
 			/* get child list */
 			trotListFree( program, &lChildList );
-			rc = trotListGetList( program, lCurrentList, index, &lChildList );
+			rc = trotListCursorGetList( program, &cursor, &lChildList );
 			ERR_IF_PASSTHROUGH;
 
 			PARANOID_ERR_IF( lChildList->laPointsTo == NULL );
 			/* if we've already encoded this list, then append the reference location
 			   Example: @.1.2.3
 			*/
-			if ( lChildList->laPointsTo->encodingChildNumber != 0 )
+			if ( lChildList->laPointsTo->encodingIndex != 0 )
 			{
 				/* append reference location */
-				rc = appendAbsTwinLocation( program, newCharacters, lChildList );
+				rc = appendAbsTwinLocation( program, newCharacters, table, lChildList );
 				ERR_IF_PASSTHROUGH;
 			}
 			/* else we havent encoded this list yet, so encode it normally */
 			else
 			{
-				lChildList->laPointsTo->encodingChildNumber = index;
-				lChildList->laPointsTo->encodingParent = lCurrentList->laPointsTo;
+				rc = tableAdd( program, &table, &tableCount, &tableSize, lChildList->laPointsTo, lCurrentList->laPointsTo->encodingIndex, index );
+				ERR_IF_PASSTHROUGH;
 
 				rc = appendLeftBracketAndTags( program, newCharacters, lChildList );
 				ERR_IF_PASSTHROUGH;
@@ -216,120 +234,16 @@ TROT_RC trotEncode( TrotProgram *program, TrotList *listToEncode, TrotList **lCh
 				lCurrentList = lChildList;
 				lChildList = NULL;
 
-				index = 0;
+				rc = trotListCursorInit( program, lCurrentList, &cursor );
+				PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 				PARANOID_ERR_IF( lCurrentList->laPointsTo == NULL );
 			}
 
 		} /* end if (kind) */
 
-		/* increment */
-		index += 1;
-
 	} /* end while(1) */
 
-	/* go through tree again, resetting encodingChildNumber and encodingParent */
-
-	/* create parent stack, so we can "go up" */
-	trotListFree( program, &lParentStack );
-	rc = trotListInit( program, &lParentStack );
-	ERR_IF_PASSTHROUGH;
-
-	trotListFree( program, &lParentIndicesStack );
-	rc = trotListInit( program, &lParentIndicesStack );
-	ERR_IF_PASSTHROUGH;
-
-	/* setup */
-	trotListFree( program, &lCurrentList );
-	rc = trotListTwin( program, listToEncode, &lCurrentList );
-	ERR_IF_PASSTHROUGH;
-
-	index = 1;
-
-	PARANOID_ERR_IF( lCurrentList->laPointsTo == NULL );
-
-	/* go through list */
-	while ( 1 )
-	{
-		/* do we have a next child? */
-
-		/* get count */
-		rc = trotListGetCount( program, lCurrentList, &childrenCount );
-		PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
-
-		/* are we out of children? */
-		if ( index > childrenCount )
-		{
-			/* do we have a parent? */
-			rc = trotListGetCount( program, lParentStack, &parentStackCount );
-			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
-
-			if ( parentStackCount == 0 )
-			{
-				/* break, we're done */
-				break;
-			}
-
-			/* go up to parent */
-			trotListFree( program, &lCurrentList );
-			rc = trotListRemoveList( program, lParentStack, -1, &lCurrentList );
-			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
-
-			rc = trotListRemoveInt( program, lParentIndicesStack, -1, &index );
-			PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
-
-			/* increment */
-			index += 1;
-
-			/* continue */
-			continue;
-		}
-
-		/* get kind */
-		rc = trotListGetKind( program, lCurrentList, index, &kind );
-		PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
-
-		if ( kind == TROT_KIND_LIST )
-		{
-			/* get child list */
-			trotListFree( program, &lChildList );
-			rc = trotListGetList( program, lCurrentList, index, &lChildList );
-			ERR_IF_PASSTHROUGH;
-
-			PARANOID_ERR_IF( lChildList->laPointsTo == NULL );
-			/* if this list has an encoding number */
-			if ( lChildList->laPointsTo->encodingChildNumber != 0 )
-			{
-				/* reset encoding members */
-				lChildList->laPointsTo->encodingChildNumber = 0;
-				lChildList->laPointsTo->encodingParent = NULL;
-
-				/* push to parent stacks, setup vars */
-				rc = trotListAppendList( program, lParentStack, lCurrentList );
-				ERR_IF_PASSTHROUGH;
-
-				rc = trotListAppendInt( program, lParentIndicesStack, index );
-				ERR_IF_PASSTHROUGH;
-
-				trotListFree( program, &lCurrentList );
-				lCurrentList = lChildList;
-				lChildList = NULL;
-
-				index = 0;
-
-				PARANOID_ERR_IF( lCurrentList->laPointsTo == NULL );
-			}
-
-		} /* end if ( kind == TROT_KIND_LIST ) */
-
-		/* increment */
-		index += 1;
-
-	} /* end while ( 1 ) */
-
-	listToEncode->laPointsTo->encodingChildNumber = 0;
-
-
 	/* give back */
 	(*lCharacters_A) = newCharacters;
 	newCharacters = NULL;
@@ -344,6 +258,17 @@ TROT_RC trotEncode( TrotProgram *program, TrotList *listToEncode, TrotList **lCh
 	trotListFree( program, &lCurrentList );
 	trotListFree( program, &lChildList );
 
+	/* the lists we encoded aren't being encoded anymore */
+	index = 0;
+	while ( index < tableCount )
+	{
+		table[ index ].la->encodingIndex = 0;
+
+		index += 1;
+	}
+
+	TROT_FREE( table, tableSize );
+
 	return rc;
 }
 
@@ -425,39 +350,45 @@ static TROT_RC appendLeftBracketAndTags( TrotProgram *program, TrotList *lCharac
 	\brief Appends encoding of a textual-reference.
 	\param[in] program List that maintains memory limit
 	\param[in] lCharacters List of characters to append to.
+	\param[in] table The encoder's table of lists it has encoded.
 	\param[in] l List we're appending the textual-reference encoding of.
 	\return TROT_RC
 
 	lCharacters will have the encoding text appended to it.
 	l will not be modified.
 */
-static TROT_RC appendAbsTwinLocation( TrotProgram *program, TrotList *lCharacters, TrotList *l )
+static TROT_RC appendAbsTwinLocation( TrotProgram *program, TrotList *lCharacters, TrotEncodingEntry *table, TrotList *l )
 {
 	/* DATA */
 	TROT_RC rc = TROT_RC_SUCCESS;
 
 	TrotList *lAddress = NULL;
+	TrotListCursor cursor;
 	TROT_INT address = 0;
 
 	TROT_INT index = 0;
 	TROT_INT count = 0;
 
-	TrotListActual *laParent = NULL;
+	TrotEncodingEntry *entry = NULL;
 
 
 	/* PRECOND */
 	PARANOID_ERR_IF( program == NULL );
 	PARANOID_ERR_IF( lCharacters == NULL );
+	PARANOID_ERR_IF( table == NULL );
 	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( l->laPointsTo->encodingIndex == 0 );
 
 
 	/* CODE */
+	entry = &( table[ l->laPointsTo->encodingIndex - 1 ] );
+
 	/* append "@" */
 	rc = trotListAppendInt( program, lCharacters, '@' );
 	ERR_IF_PASSTHROUGH;
 
-	/* if encodingChildNumber is -1, just need "@" */
-	if ( l->laPointsTo->encodingChildNumber == -1 )
+	/* if it's the list we're encoding, just need "@" */
+	if ( entry->parent == 0 )
 	{
 		/* append space */
 		rc = trotListAppendInt( program, lCharacters, ' ' );
@@ -470,26 +401,30 @@ static TROT_RC appendAbsTwinLocation( TrotProgram *program, TrotList *lCharacter
 	rc = trotListInit( program, &lAddress );
 	ERR_IF_PASSTHROUGH;
 
-	laParent = l->laPointsTo;
-	while ( laParent->encodingChildNumber > 0 )
+	while ( entry->parent != 0 )
 	{
-		rc = trotListInsertInt( program, lAddress, 1, laParent->encodingChildNumber );
+		rc = trotListInsertInt( program, lAddress, 1, entry->childNumber );
 		ERR_IF_PASSTHROUGH;
 
-		laParent = laParent->encodingParent;
-		PARANOID_ERR_IF( laParent == NULL );
+		entry = &( table[ entry->parent - 1 ] );
 	}
 
 	/* get count */
 	rc = trotListGetCount( program, lAddress, &count );
 	PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
+	rc = trotListCursorInit( program, lAddress, &cursor );
+	PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
+
 	/* foreach parent */
 	index = 1;
 	while ( index <= count )
 	{
 		/* get parent */
-		rc = trotListGetInt( program, lAddress, index, &address );
+		rc = trotListCursorNext( program, &cursor );
+		PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
+
+		rc = trotListCursorGetInt( program, &cursor, &address );
 		PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
 
 		/* append '.' */
@@ -596,3 +531,61 @@ static TROT_RC appendNumber( TrotProgram *program, TrotList *lCharacters, TROT_I
 	return rc;
 }
 
+/******************************************************************************/
+/*!
+	\brief Adds a list to the encoder's table of lists it has encoded.
+	\param[in] program List that maintains memory limit
+	\param[in,out] table The table. Will be grown if it's full.
+	\param[in,out] tableCount How many entries are in table.
+	\param[in,out] tableSize How many entries fit in table.
+	\param[in] la The list.
+	\param[in] parent encodingIndex of the list la was first found in, or 0 if
+		la is the list we're encoding.
+	\param[in] childNumber Which child of parent la is.
+	\return TROT_RC
+
+	On success, la's encodingIndex will be set.
+*/
+static TROT_RC tableAdd( TrotProgram *program, TrotEncodingEntry **table, TROT_INT *tableCount, TROT_INT *tableSize, TrotListActual *la, TROT_INT parent, TROT_INT childNumber )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TROT_INT newSize = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( table == NULL );
+	PARANOID_ERR_IF( tableCount == NULL );
+	PARANOID_ERR_IF( tableSize == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( la->encodingIndex != 0 );
+
+
+	/* CODE */
+	if ( (*tableCount) == (*tableSize) )
+	{
+		ERR_IF( (*tableSize) > ( TROT_INT_MAX / 2 ) / (TROT_INT)sizeof( TrotEncodingEntry ), TROT_RC_ERROR_MEM_LIMIT );
+
+		newSize = (*tableSize) == 0 ? TROT_NODE_SIZE : (*tableSize) * 2;
+
+		TROT_REALLOC( (*table), (*tableSize), newSize );
+
+		(*tableSize) = newSize;
+	}
+
+	(*table)[ (*tableCount) ].la = la;
+	(*table)[ (*tableCount) ].parent = parent;
+	(*table)[ (*tableCount) ].childNumber = childNumber;
+
+	(*tableCount) += 1;
+
+	la->encodingIndex = (*tableCount);
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
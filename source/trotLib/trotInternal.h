@@ -34,6 +34,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /******************************************************************************/
 #include <stdio.h> /* for printf, fprintf, fflush */
 #include <stdlib.h> /* for NULL */
+#include <string.h> /* for memcpy, memmove, memset */
 
 #include "trot.h"
 
@@ -88,7 +89,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define TROT_MALLOC( POINTER, SIZE ) \
 	ERR_IF( ( program->memoryLimit - ((TROT_INT)( sizeof( * (POINTER) ) * (SIZE) )) ) < program->memoryUsed, \
 	        TROT_RC_ERROR_MEM_LIMIT ); \
-	POINTER = TROT_HOOK_MALLOC( sizeof( * (POINTER) ) * (SIZE) ); \
+	POINTER = trotSlabMalloc( program, sizeof( * (POINTER) ) * (SIZE) ); \
 	ERR_IF( (POINTER) == NULL, TROT_RC_ERROR_MEMORY_ALLOCATION_FAILED ); \
 	program->memoryUsed += ( sizeof( * (POINTER) ) * (SIZE) );
 
@@ -96,30 +97,174 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define TROT_CALLOC( POINTER, SIZE ) \
 	ERR_IF( ( program->memoryLimit - ((TROT_INT)( sizeof( * (POINTER) ) * (SIZE) )) ) < program->memoryUsed, \
 	        TROT_RC_ERROR_MEM_LIMIT ); \
-	POINTER = TROT_HOOK_CALLOC( SIZE, sizeof( * (POINTER) ) ); \
+	POINTER = trotSlabCalloc( program, sizeof( * (POINTER) ) * (SIZE) ); \
 	ERR_IF( (POINTER) == NULL, TROT_RC_ERROR_MEMORY_ALLOCATION_FAILED ); \
 	program->memoryUsed += ( sizeof( * (POINTER) ) * (SIZE) );
 
 /******************************************************************************/
+#define TROT_REALLOC( POINTER, OLD_SIZE, NEW_SIZE ) \
+	ERR_IF( ( program->memoryLimit - ((TROT_INT)( sizeof( * (POINTER) ) * (NEW_SIZE) )) ) \
+	        < ( program->memoryUsed - ((TROT_INT)( sizeof( * (POINTER) ) * (OLD_SIZE) )) ), \
+	        TROT_RC_ERROR_MEM_LIMIT ); \
+	{ \
+		void *trotReallocated = trotSlabRealloc( program, POINTER, sizeof( * (POINTER) ) * (OLD_SIZE), sizeof( * (POINTER) ) * (NEW_SIZE) ); \
+		ERR_IF( trotReallocated == NULL, TROT_RC_ERROR_MEMORY_ALLOCATION_FAILED ); \
+		POINTER = trotReallocated; \
+	} \
+	program->memoryUsed -= ( sizeof( * (POINTER) ) * (OLD_SIZE) ); \
+	program->memoryUsed += ( sizeof( * (POINTER) ) * (NEW_SIZE) );
+
 #define TROT_FREE( POINTER, SIZE ) \
 	if ( POINTER != NULL ) \
 	{ \
 		program->memoryUsed -= ( sizeof( * (POINTER) ) * (SIZE) ); \
-		TROT_HOOK_FREE( POINTER ); \
+		trotSlabFree( program, POINTER, sizeof( * (POINTER) ) * (SIZE) ); \
 	}
 /* TODO: TROT_FREE should set pointer to NULL? */
 
+/******************************************************************************/
+/* allocations of up to TROT_SLAB_MAX bytes come from per-program slabs instead
+   of TROT_HOOK_MALLOC. sizes are rounded up to TROT_SLAB_GRAIN, which must be
+   big enough to hold two pointers and keep everything aligned, and each size
+   has its own free list. a slab holds TROT_SLAB_OBJECTS objects of one size.
+   bigger allocations get a TROT_SLAB_GRAIN header that links them into the
+   program, so freeing a program frees everything it allocated. */
+#ifndef TROT_SLAB_GRAIN
+#define TROT_SLAB_GRAIN 16
+#endif
+
+#ifndef TROT_SLAB_MAX
+#define TROT_SLAB_MAX 256
+#endif
+
+#ifndef TROT_SLAB_OBJECTS
+#define TROT_SLAB_OBJECTS 64
+#endif
+
+#define TROT_SLAB_CLASSES ( TROT_SLAB_MAX / TROT_SLAB_GRAIN )
+
+/******************************************************************************/
+/* when a program's gcMode is TROT_GC_DEFERRED, its collector runs in steps.
+   the collector goes through these phases in order. */
+#define GC_PHASE_IDLE 0
+/* looking through the heap for lists with client refs */
+#define GC_PHASE_ROOTS 1
+/* marking what the marked lists hold */
+#define GC_PHASE_MARK 2
+/* taking lists that weren't marked out of the heap */
+#define GC_PHASE_SWEEP 3
+/* freeing the data of lists that weren't marked */
+#define GC_PHASE_FREE_DATA 4
+/* freeing the lists that weren't marked */
+#define GC_PHASE_FREE_LISTS 5
+
+/* when a program's gcMode is TROT_GC_CYCLES, this is the color of a list,
+   kept in flagVisited */
+/* in use, or not looked at */
+#define GC_COLOR_BLACK 0
+/* being looked at by the cycle collector, and garbage if it stays gray */
+#define GC_COLOR_GRAY 1
+/* lost a ref and might be part of a garbage cycle */
+#define GC_COLOR_PURPLE 2
+
+/* how many lists can be waiting to be looked at by the cycle collector before
+   it runs */
+#ifndef TROT_GC_ROOTS
+#define TROT_GC_ROOTS 1024
+#endif
+
+/* how much work a trotProgramGcStep does by default. a list and an item
+   in a list are each one unit of work. */
+#ifndef TROT_GC_BUDGET
+#define TROT_GC_BUDGET 1024
+#endif
+
 /******************************************************************************/
 #ifndef TROT_NODE_SIZE
 #define TROT_NODE_SIZE 16
 #endif
 
+/******************************************************************************/
+/* nodes start out with room for TROT_NODE_SIZE items. as a list gets bigger,
+   new nodes get twice as much room, up to TROT_NODE_SIZE_MAX, so big lists
+   don't need as many nodes. a list gets bigger nodes once it has
+   TROT_NODE_GROWTH nodes worth of items. */
+#ifndef TROT_NODE_SIZE_MAX
+#define TROT_NODE_SIZE_MAX 256
+#endif
+
+#ifndef TROT_NODE_GROWTH
+#define TROT_NODE_GROWTH 32
+#endif
+
+/******************************************************************************/
+/* when a remove leaves a node with less than this many items, it's merged
+   with one of its neighbours */
+#ifndef TROT_NODE_UNDERFLOW
+#define TROT_NODE_UNDERFLOW ( TROT_NODE_SIZE / 4 )
+#endif
+
+/* how many trotListRefs fit in the node that's inside every TrotListActual.
+   the same space holds twice as many TROT_INTs, or half as many mixed slots.
+   lists that never have more than that many items never allocate a node.
+   can't be more than TROT_NODE_SIZE, so the inline node always fits into a
+   normal node when it has to be moved out of its list. */
+#ifndef TROT_LIST_INLINE
+#if TROT_NODE_SIZE < 8
+#define TROT_LIST_INLINE TROT_NODE_SIZE
+#else
+#define TROT_LIST_INLINE 8
+#endif
+#endif
+
+/* when an item is added next to a node of the other kind that has at most
+   this many items, the node is turned into a mixed node instead of adding a
+   new node. this keeps lists that alternate kinds from having a node per
+   item. */
+#ifndef TROT_NODE_MIX
+#define TROT_NODE_MIX ( TROT_NODE_SIZE / 4 )
+#endif
+
+/******************************************************************************/
+#ifndef TROT_INDEX_SIZE
+#define TROT_INDEX_SIZE 16
+#endif
+
 /******************************************************************************/
 #define NODE_KIND_INT 1
 #define NODE_KIND_LIST 2
+/* only nodes are mixed, items are always NODE_KIND_INT or NODE_KIND_LIST */
+#define NODE_KIND_MIXED 3
+
+/* a node's items are right after it */
+#define NODE_INTS( NODE ) ( (void *)( (NODE) + 1 ) )
+#define NODE_LISTS( NODE ) ( (TrotList **)( (NODE) + 1 ) )
+#define NODE_SLOTS( NODE ) ( (TrotListSlot *)( (NODE) + 1 ) )
 
 /******************************************************************************/
-#define REF_LIST_NODE_SIZE 16
+/* int nodes store their ints in as few bytes as they can. a node starts out
+   as narrow as its ints allow, and is made wider the first time an int that
+   doesn't fit is put into it. */
+#define NODE_WIDTH_8 1
+#define NODE_WIDTH_16 2
+#define NODE_WIDTH_FULL ( (TROT_INT)sizeof( TROT_INT ) )
+
+/* a run node is an int node that holds count copies of one int, so fills
+   and sparse lists don't need memory for every item. it stores its int
+   once, right after the node, and its width is NODE_WIDTH_RUN. its capacity
+   is always its count, so it never looks like it has room. */
+#define NODE_WIDTH_RUN 0
+
+/* gets the address of int I in int node NODE */
+#define NODE_INT_AT( NODE, I ) \
+	( (void *)( ( (char *)NODE_INTS( NODE ) ) + ( (I) * (NODE)->width ) ) )
+
+/* gets int I from int node NODE */
+#define NODE_GET_INT( NODE, I ) \
+	(   (NODE)->width == NODE_WIDTH_8   ? (TROT_INT)( ( (u8 *)NODE_INTS( NODE ) )[ I ] )  \
+	  : (NODE)->width == NODE_WIDTH_16  ? (TROT_INT)( ( (u16 *)NODE_INTS( NODE ) )[ I ] ) \
+	  : (NODE)->width == NODE_WIDTH_RUN ? ( (TROT_INT *)NODE_INTS( NODE ) )[ 0 ]          \
+	  :                                   ( (TROT_INT *)NODE_INTS( NODE ) )[ I ] )
 
 /******************************************************************************/
 /* FUTURE: these may change, or how we execute them may change */
@@ -164,56 +309,125 @@ typedef enum
 typedef struct TrotList_STRUCT TrotList;
 typedef struct TrotListActual_STRUCT TrotListActual;
 typedef struct TrotListNode_STRUCT TrotListNode;
-typedef struct TrotListRefListNode_STRUCT TrotListRefListNode;
+typedef struct TrotListSlot_STRUCT TrotListSlot;
+typedef struct TrotListIndexNode_STRUCT TrotListIndexNode;
+
+/*! A slot in a mixed node, which can hold either a TROT_INT or a
+trotListRef. */
+struct TrotListSlot_STRUCT
+{
+	/*! kind is NODE_KIND_INT or NODE_KIND_LIST, or 0 if the slot is unused. */
+	TROT_INT kind;
+	union
+	{
+		/*! the int, if kind is NODE_KIND_INT */
+		TROT_INT n;
+		/*! the list, if kind is NODE_KIND_LIST */
+		TrotList *l;
+	} u;
+};
 
-/*! Data in a TrotList is stored in a linked list of trotListNodes. */
+/*! Data in a TrotList is stored in a linked list of trotListNodes. A node's
+items are right after it, in the same allocation, except for a list's
+inlineNode, whose items are in inlineItems, which comes right after it. Use
+NODE_INTS, NODE_LISTS, and NODE_SLOTS to get at them. */
 struct TrotListNode_STRUCT
 {
+	/*! next points to the next node in the linked list. The last node's
+	next is the list's head, so the list is a circle. Nodes don't point
+	back, use trotListNodePrev to find the node before a node. */
+	struct TrotListNode_STRUCT *next;
+
+	/*! parent is the index node that holds this node, or NULL if the list
+	doesn't need an index because it has less than 2 nodes. */
+	TrotListIndexNode *parent;
+
 	/*! count is how many TROT_INTs or trotListRefs are in this node. */
-/* FUTURE: this could be made smaller by using a u8, since we're not going to have more than 256 sized nodes? */
 	TROT_INT count;
-	/*! if kind is NODE_KIND_INT, then n will point to an array of size
-	TROT_NODE_SIZE of type TROT_INT, else n will be NULL. */
-	TROT_INT *n;
-	/*! if kind is NODE_KIND_LIST, then l will point to an array of size
-	TROT_NODE_SIZE of type trotList*, else l will be NULL. */
-	TrotList **l;
-
-/* FUTURE: we don't need a double linked list, change this to single */
-	/*! prev points to previous node in the linked list, or same node if
-	this is the head of the list. */
-	struct TrotListNode_STRUCT *prev;
-	/*! next points to the next node in the linked list, or same node if
-	this is the tail of the list. */
-	struct TrotListNode_STRUCT *next;
+	/*! capacity is how many items fit in this node. Between TROT_NODE_SIZE and
+	TROT_NODE_SIZE_MAX, or less for a list's inlineNode. */
+	TROT_INT capacity;
+	/*! slot is where this node is in parent's children. */
+	TROT_INT slot;
+
+	/*! kind is NODE_KIND_INT if this node holds an array of capacity ints that
+	are width bytes each, NODE_KIND_LIST if it holds an array of capacity
+	trotList*s, or NODE_KIND_MIXED if it holds an array of capacity
+	TrotListSlots, whose unused slots are all zero. kind is 0 if this node
+	holds nothing, like the sentinels, or an inlineNode that isn't in use. */
+	u8 kind;
+	/*! if kind is NODE_KIND_INT, width is how many bytes each int takes,
+	NODE_WIDTH_8, NODE_WIDTH_16, or NODE_WIDTH_FULL, or NODE_WIDTH_RUN if
+	this is a run node. Else it's 0. Use NODE_GET_INT to read them. */
+	u8 width;
+};
+
+/*! The nodes of a list are also the leaves of a counted B+tree, so we can find
+the node that holds an index in O(log n) instead of walking the linked list.
+Every index node caches how many TROT_INTs or trotListRefs are under each of
+its children. */
+struct TrotListIndexNode_STRUCT
+{
+	/*! level is 1 if children are TrotListNodes, else children are
+	TrotListIndexNodes with a level one less than this one. */
+	TROT_INT level;
+	/*! used is how many children this index node has. */
+	TROT_INT used;
+	/*! parent is the index node that holds this index node, or NULL if this
+	is the root. */
+	TrotListIndexNode *parent;
+	/*! slot is where this index node is in parent's children. */
+	TROT_INT slot;
+	/*! counts[ i ] is how many TROT_INTs or trotListRefs are under
+	children[ i ]. */
+	TROT_INT counts[ TROT_INDEX_SIZE ];
+	/*! children are TrotListNode* or TrotListIndexNode*, depending on
+	level. */
+	void *children[ TROT_INDEX_SIZE ];
+};
+
+/*! TrotList is a reference to a TrotListActual */
+struct TrotList_STRUCT
+{
+	/*! The list that this ref is inside of. */
+	TrotListActual *laParent;
+	/*! The list that this ref points to. */
+	TrotListActual *laPointsTo;
+	/*! The previous ref in laPointsTo's refList. The first ref's refPrev is
+	the last ref, so refs can be added at the back. */
+	TrotList *refPrev;
+	/*! The next ref in laPointsTo's refList, or NULL if this is the last. */
+	TrotList *refNext;
 };
 
 /*! trotListActual is the main data structure in Trot. */
 struct TrotListActual_STRUCT
 {
-	/*! Flag that says whether this list is still reachable or not. If not
-	reachable, then this list can be freed */
-	TROT_INT reachable;
-	/*! Flag for 'is list reachable' so we don't get into an infinite
-	    loop */
-	TROT_INT flagVisited;
-	/*! Pointer to "previous" list. Used when we're seeing if a list is
-	    reachable */
-	TrotListActual *previous;
-	/*! Pointer to "nextToFree" list. Only set when this list is no longer
-	    reachable. We use this to keep a linked list of lists that need to
-	    be freed. */
-/* FUTURE: we could save space by combining these 3 trotlistactual pointers,
-since it doesnt seem they're ever used at the same time */
-	TrotListActual *nextToFree;
-
-/* FUTURE: we could change our encoding to only need 1 value, not parent and number
-if it kept track of each lists reference number */
-	/*! Pointer to "parent" when we're encoding a list */
-	TrotListActual *encodingParent;
-	/*! The child number this list is of it's parent, used for managing
-	    twins when encoding */
-	TROT_INT encodingChildNumber;
+	/*! Only one of these is used at a time. 'is list reachable' never goes
+	into a list that isn't reachable, and only lists that aren't reachable
+	are put on the list of lists that need to be freed. trotListCollect uses
+	nextToFree for its stack of lists to mark, and then for the lists it
+	frees. */
+	union
+	{
+		/*! Pointer to "previous" list. Used when we're seeing if a list is
+		    reachable */
+		TrotListActual *previous;
+		/*! Pointer to "nextToFree" list. Only set when this list is no
+		    longer reachable. We use this to keep a linked list of lists
+		    that need to be freed. */
+		TrotListActual *nextToFree;
+	} link;
+
+	/*! Next list in the program's heap, if the program's gcMode is
+	TROT_GC_DEFERRED. New lists go at the front. If the program's gcMode is
+	TROT_GC_CYCLES, next list in the program's gcRoots instead. */
+	TrotListActual *heapNext;
+
+	/*! Where this list is in the encoder's table of lists it has seen, plus
+	    one, or 0 if we're not encoding it. Everything else the encoder needs
+	    to know about this list is in that table. */
+	TROT_INT encodingIndex;
 
 	/*! Type. Which type of list this is. */
 	TROT_INT type;
@@ -221,38 +435,110 @@ if it kept track of each lists reference number */
 	TROT_INT tag;
 	/*! How many children are in the list */
 	TROT_INT childrenCount;
-	/*! Pointer to the head of the linked list that contains the refs that
-	point to this list. Used for checking whether this list is still
-	reachable or not. */
-	TrotListRefListNode *refList;
-	/*! Pointer to the tail of the linked list that contains the refs that
-	point to this list. Used for checking whether this list is still
-	reachable or not. */
-	/*! Pointer to the head of the linked list that contains the actual data
-	in the list. */
-	TrotListNode *head;
-	/*! Pointer to the tail of the linked list that contains the actual data
-	in the list. */
-	TrotListNode *tail;
+	/*! The first ref that points to this list, or NULL if nothing does. The
+	rest are linked by their refNext and refPrev, so a ref can be taken out
+	without searching. Client refs, refs that aren't in a list, come first,
+	so a list with a client ref, which is reachable, is found without
+	searching. Used for checking whether this list is still reachable or
+	not. */
+	TrotList *refList;
+	/*! Pointer to the last node in the linked list that contains the actual
+	data in the list, or headNode if the list has no nodes. */
+	TrotListNode *last;
+	/*! Root of the index over the nodes, or NULL if the list has less than 2
+	nodes. */
+	TrotListIndexNode *indexRoot;
+	/*! The node that the last indexed operation found, or NULL. Lists are
+	usually walked in order, so the next lookup will often be in this node
+	or one next to it. */
+	TrotListNode *fingerNode;
+	/*! How many items are in the nodes before fingerNode. */
+	TROT_INT fingerStart;
+	/*! Flag that says whether this list is still reachable or not. If not
+	reachable, then this list can be freed */
+	u8 reachable;
+	/*! Flag for 'is list reachable' so we don't get into an infinite
+	    loop. When the program's gcMode is TROT_GC_DEFERRED, this is the
+	    collector's mark instead, see gcEpoch. When it's TROT_GC_CYCLES,
+	    this is the list's GC_COLOR. */
+	u8 flagVisited;
+	/*! Flag for whether this list is in the program's gcRoots. */
+	u8 flagBuffered;
+
+	/*! The head sentinel of the linked list that contains the actual data
+	in the list, and the first ref that trotListInit gives back, are both
+	part of this structure, so a new list is a single allocation.
+	firstRef is never freed on its own, it goes away when the list is
+	freed. */
+	TrotListNode headNode;
+	TrotList firstRef;
+
+	/*! A node whose items are in inlineItems, so small lists don't need to
+	allocate any nodes. It's only handed out when the list is empty, and
+	it's replaced by a normal node when it's full and needs to grow. It's
+	in use when its kind is set. */
+	TrotListNode inlineNode;
+	/*! Items of inlineNode. inlineNode's capacity depends on its kind. */
+	TrotList *inlineItems[ TROT_LIST_INLINE ];
 };
 
-/*! TrotList is a reference to a TrotListActual */
-struct TrotList_STRUCT
+/*! Cursor for walking through a list one item at a time. Holds the node
+and offset of the current item, so moving to the next or previous item
+doesn't have to find the index from the top of the list.
+A cursor is only good until its list is changed by something other than the
+cursor itself. */
+typedef struct
 {
-	/*! The list that this ref is inside of. */
-	TrotListActual *laParent;
-	/*! The list that this ref points to. */
-	TrotListActual *laPointsTo;
+	/*! The list we're walking through. */
+	TrotList *l;
+	/*! The node that holds the item at the cursor, or NULL if the cursor is
+	before the first item or after the last item. */
+	TrotListNode *node;
+	/*! Where the item at the cursor is in node. */
+	TROT_INT i;
+	/*! Index of the item at the cursor. 0 if the cursor is before the first
+	item, and count + 1 if it's after the last item. */
+	TROT_INT index;
+} TrotListCursor;
+
+/*! What the encoder remembers about a list it has encoded, so it can give the
+address of its twins. Kept in a table while encoding, instead of in every
+TrotListActual. */
+typedef struct
+{
+	/*! The list. Its encodingIndex is where this is in the table, plus one. */
+	TrotListActual *la;
+	/*! encodingIndex of the list this list was first found in, or 0 if this is
+	the list we're encoding. */
+	TROT_INT parent;
+	/*! Which child of parent this list is. */
+	TROT_INT childNumber;
+} TrotEncodingEntry;
+
+/*! A slab of small objects. The objects start TROT_SLAB_GRAIN bytes in. */
+typedef struct TrotSlab_STRUCT TrotSlab;
+struct TrotSlab_STRUCT
+{
+	/*! Next slab of the program. */
+	TrotSlab *next;
 };
 
-/*! Structure for holding a linked list of references. Used in TrotList to keep
-track of which references points to the trotList. */
-struct TrotListRefListNode_STRUCT
+/*! A block too big for a slab. The memory starts TROT_SLAB_GRAIN bytes in. */
+typedef struct TrotBigBlock_STRUCT TrotBigBlock;
+struct TrotBigBlock_STRUCT
 {
-	/*! l is the reference */
-	TrotList *l;
-	/*! points to the next node in the linked list */
-	TrotListRefListNode *next;
+	/*! Previous big block of the program. */
+	TrotBigBlock *prev;
+	/*! Next big block of the program. */
+	TrotBigBlock *next;
+};
+
+/*! A free object in a slab. */
+typedef struct TrotSlabFree_STRUCT TrotSlabFree;
+struct TrotSlabFree_STRUCT
+{
+	/*! Next free object of the same size. */
+	TrotSlabFree *next;
 };
 
 /******************************************************************************/
@@ -267,6 +553,47 @@ struct TrotProgram_STRUCT
 	TROT_INT cycles;
 	/*! The list of threads in this program */
 	TrotList *lThreadList;
+	/*! Allocator given to trotProgramLoad. All NULL for the default. */
+	TrotAllocator allocator;
+	/*! TROT_GC_IMMEDIATE, TROT_GC_DEFERRED, or TROT_GC_CYCLES. */
+	TROT_INT gcMode;
+	/*! Every list of the program, if gcMode is TROT_GC_DEFERRED. */
+	TrotListActual *heap;
+	/*! How many refs have been freed since the last collection started. */
+	TROT_INT gcFrees;
+	/*! How much work trotProgramGcStep does, see TROT_GC_BUDGET. */
+	TROT_INT gcBudget;
+	/*! Which GC_PHASE the collector is in. */
+	TROT_INT gcPhase;
+	/*! Lists whose flagVisited is gcEpoch are marked. It changes between 1
+	and 2 each collection, so lists never have to be unmarked. */
+	u8 gcEpoch;
+	/*! Lists that have been marked but not scanned, linked by
+	link.nextToFree. */
+	TrotListActual *gcStack;
+	/*! Next list to look at in GC_PHASE_ROOTS and GC_PHASE_FREE_DATA. */
+	TrotListActual *gcCursor;
+	/*! Where GC_PHASE_SWEEP is in the heap. */
+	TrotListActual **gcSweep;
+	/*! Lists that weren't marked, linked by link.nextToFree. */
+	TrotListActual *gcGarbage;
+	/*! Lists that might be part of a garbage cycle, if gcMode is
+	TROT_GC_CYCLES. Linked by heapNext. */
+	TrotListActual *gcRoots;
+	/*! How many lists are in gcRoots. */
+	TROT_INT gcRootsCount;
+	/*! Free objects of each slab size. */
+	TrotSlabFree *slabFree[ TROT_SLAB_CLASSES ];
+	/*! All slabs this program has allocated. */
+	TrotSlab *slabs;
+	/*! How many slabs this program has allocated. */
+	TROT_INT slabCount;
+	/*! How many bytes this program's slabs take up. */
+	TROT_INT slabBytes;
+	/*! How many slab objects are being used. */
+	TROT_INT slabObjects;
+	/*! All blocks too big for a slab. */
+	TrotBigBlock *bigBlocks;
 };
 
 /******************************************************************************/
@@ -274,6 +601,9 @@ struct TrotProgram_STRUCT
 TROT_RC trotListInit( TrotProgram *program, TrotList **l_A );
 TROT_RC trotListTwin( TrotProgram *program, TrotList *l, TrotList **lTwin_A );
 void trotListFree( TrotProgram *program, TrotList **l_F );
+void trotListCollect( TrotProgram *program );
+TROT_INT trotListCollectStep( TrotProgram *program, TROT_INT budget );
+void trotListCollectCycles( TrotProgram *program );
 
 TROT_RC trotListRefCompare( TrotProgram *program, TrotList *l1, TrotList *l2, TROT_INT *isSame );
 
@@ -297,18 +627,58 @@ TROT_RC trotListRemove( TrotProgram *program, TrotList *l, TROT_INT index );
 TROT_RC trotListReplaceWithInt( TrotProgram *program, TrotList *l, TROT_INT index, TROT_INT n );
 TROT_RC trotListReplaceWithList( TrotProgram *program, TrotList *l, TROT_INT index, TrotList *lToInsert );
 
+TROT_RC trotListAppendInts( TrotProgram *program, TrotList *l, const TROT_INT *src, TROT_INT count );
+TROT_RC trotListAppendRun( TrotProgram *program, TrotList *l, TROT_INT n, TROT_INT count );
+TROT_RC trotListInsertInts( TrotProgram *program, TrotList *l, TROT_INT index, const TROT_INT *src, TROT_INT count );
+TROT_RC trotListGetInts( TrotProgram *program, TrotList *l, TROT_INT start, TROT_INT count, TROT_INT *dst );
+
+TROT_RC trotListRemoveRange( TrotProgram *program, TrotList *l, TROT_INT start, TROT_INT end );
+TROT_RC trotListReplaceRange( TrotProgram *program, TrotList *l, TROT_INT start, TROT_INT end, TrotList *lReplacement );
+TROT_RC trotListSlice( TrotProgram *program, TrotList *l, TROT_INT start, TROT_INT end, TrotList **lSlice_A );
+
+TROT_RC trotListConcat( TrotProgram *program, TrotList *l, TrotList *lFrom );
+TROT_RC trotListSplitAt( TrotProgram *program, TrotList *l, TROT_INT index, TrotList **lRest_A );
+
+TROT_RC trotListCompact( TrotProgram *program, TrotList *l );
+
 TROT_RC trotListGetType( TrotProgram *program, TrotList *l, TROT_INT *type );
 TROT_RC trotListSetType( TrotProgram *program, TrotList *l, TROT_INT type );
 
 TROT_RC trotListGetTag( TrotProgram *program, TrotList *l, TROT_INT *tag );
 TROT_RC trotListSetTag( TrotProgram *program, TrotList *l, TROT_INT tag );
 
+void trotListFindNode( TrotListActual *la, TROT_INT index, TrotListNode **node, TROT_INT *count );
+TrotListNode *trotListNodePrev( TrotListActual *la, TrotListNode *node );
+TROT_INT trotListNodeGetKind( TrotListNode *node, TROT_INT i );
+
+/******************************************************************************/
+/* trotProgram.c */
+void *trotSlabMalloc( TrotProgram *program, size_t size );
+void *trotSlabCalloc( TrotProgram *program, size_t size );
+void *trotSlabRealloc( TrotProgram *program, void *p, size_t oldSize, size_t newSize );
+void trotSlabFree( TrotProgram *program, void *p, size_t size );
+
+/******************************************************************************/
+/* trotListCursor.c */
+TROT_RC trotListCursorInit( TrotProgram *program, TrotList *l, TrotListCursor *c );
+TROT_RC trotListCursorNext( TrotProgram *program, TrotListCursor *c );
+TROT_RC trotListCursorPrev( TrotProgram *program, TrotListCursor *c );
+TROT_RC trotListCursorSeek( TrotProgram *program, TrotListCursor *c, TROT_INT index );
+
+TROT_RC trotListCursorGetKind( TrotProgram *program, TrotListCursor *c, TROT_INT *kind );
+TROT_RC trotListCursorGetInt( TrotProgram *program, TrotListCursor *c, TROT_INT *n );
+TROT_RC trotListCursorGetList( TrotProgram *program, TrotListCursor *c, TrotList **lTwin_A );
+
+TROT_RC trotListCursorInsertInt( TrotProgram *program, TrotListCursor *c, TROT_INT n );
+TROT_RC trotListCursorInsertList( TrotProgram *program, TrotListCursor *c, TrotList *lToInsert );
+TROT_RC trotListCursorRemove( TrotProgram *program, TrotListCursor *c );
+
 /******************************************************************************/
 /* trotDecoding.c */
 TROT_RC trotDecode( TrotProgram *program, TrotList *lCharacters, TrotList **lDecodedList_A );
 
 /******************************************************************************/
-/* trotDecoding.c */
+/* trotEncoding.c */
 TROT_RC trotEncode( TrotProgram *program, TrotList *listToEncode, TrotList **lCharacters_A );
 
 /******************************************************************************/
@@ -324,6 +694,11 @@ TROT_RC trotEncode( TrotProgram *program, TrotList *listToEncode, TrotList **lCh
 	#define TROT_HOOK_CALLOC trotHookCalloc
 	#endif
 
+	extern void *trotHookRealloc( void *ptr, size_t size );
+	#ifndef TROT_HOOK_REALLOC
+	#define TROT_HOOK_REALLOC trotHookRealloc
+	#endif
+
 	extern void trotHookFree( void *ptr );
 	#ifndef TROT_HOOK_FREE
 	#define TROT_HOOK_FREE trotHookFree
@@ -339,6 +714,10 @@ TROT_RC trotEncode( TrotProgram *program, TrotList *listToEncode, TrotList **lCh
 	#define TROT_HOOK_CALLOC calloc
 	#endif
 
+	#ifndef TROT_HOOK_REALLOC
+	#define TROT_HOOK_REALLOC realloc
+	#endif
+
 	#ifndef TROT_HOOK_FREE
 	#define TROT_HOOK_FREE free
 	#endif
@@ -41,6 +41,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 	- Get Kind (is child at index N an int or list?)
 	- Append Int
 	- Append List Twin
+	- Append, Insert, and Get arrays of Ints
+	- Remove, Replace, and Slice ranges
+	- Concat and Split At
+	- Compact
 	- Get Int
 	- Get List Twin
 	- Remove Int
@@ -55,15 +59,84 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "trotInternal.h"
 
 /******************************************************************************/
-static TROT_RC trotListNodeSplit( TrotProgram *program, TrotListNode *n, TROT_INT keepInLeft );
+static TROT_RC trotListNodeSplit( TrotProgram *program, TrotListActual *la, TrotListNode *n, TROT_INT keepInLeft );
 
-static TROT_RC newIntNode( TrotProgram *program, TrotListNode *insertBeforeThis, TROT_INT n );
+static TROT_RC newIntNode( TrotProgram *program, TrotListActual *la, TrotListNode *insertBeforeThis, TROT_INT n );
 static TROT_RC newListNode( TrotProgram *program, TrotListActual *la, TrotListNode *insertBeforeThis, TrotList *l );
-
-static TROT_RC refListAdd( TrotProgram *program, TrotListActual *la, TrotList *l );
+static TROT_RC insertIntsAfter( TrotProgram *program, TrotListActual *la, TrotListNode *prevNode, const TROT_INT *src, TROT_INT count );
+static TROT_RC copyItemsAfter( TrotProgram *program, TrotListActual *la, TrotListNode *prevNode, TrotListNode *fromNode, TROT_INT fromI, TROT_INT count );
+static void removeItems( TrotProgram *program, TrotListActual *la, TrotListNode *node, TROT_INT i, TROT_INT count );
+static void freeRefs( TrotProgram *program, TrotList **refs, TROT_INT count );
+static void reparentNodes( TrotProgram *program, TrotListActual *laFrom, TrotListActual *la, TrotListNode *node, TrotListNode *end );
+static void removeNode( TrotProgram *program, TrotListActual *la, TrotListNode *node );
+static TROT_RC nodeAlloc( TrotProgram *program, TrotListActual *la, TROT_INT kind, TROT_INT width, TROT_INT count, TrotListNode **node_A );
+static void nodeFree( TrotProgram *program, TrotListActual *la, TrotListNode *node );
+static void nodeReplace( TrotListActual *la, TrotListNode *oldNode, TrotListNode *newNode );
+static TROT_RC nodeRealloc( TrotProgram *program, TrotListActual *la, TrotListNode **node );
+static TROT_RC nodeMakeRoom( TrotProgram *program, TrotListActual *la, TrotListNode **node );
+static TROT_INT inlineNodeUsed( TrotListActual *la );
+static TROT_INT inlineCapacity( TROT_INT kind );
+static TROT_INT nodeCapacity( TROT_INT size, TROT_INT count );
+static TROT_INT nodeBytes( TROT_INT kind, TROT_INT width, TROT_INT capacity );
+static TROT_INT nodeKind( TrotListNode *node );
+static void nodeMerge( TrotProgram *program, TrotListActual *la, TrotListNode *node );
+static void moveItems( TrotProgram *program, TrotListActual *la, TrotListNode *to, TrotListNode *from, TROT_INT count );
+static TROT_INT canMove( TrotListNode *to, TrotListNode *from );
+
+static TROT_INT intWidth( TROT_INT n );
+static TROT_INT intsWidth( const TROT_INT *src, TROT_INT count );
+static void nodeSetInt( TrotListNode *node, TROT_INT i, TROT_INT n );
+static void copyInts( TrotListNode *to, TROT_INT toI, TrotListNode *from, TROT_INT fromI, TROT_INT count );
+static TROT_RC nodeWiden( TrotProgram *program, TrotListActual *la, TrotListNode **node, TROT_INT width );
+static TROT_INT nodeIntsWidth( TrotListNode *node );
+
+static TROT_INT nodeIsRun( TrotListNode *node );
+static TROT_INT nodeIsAll( TrotListNode *node, TROT_INT n );
+static TROT_RC nodeAllocRun( TrotProgram *program, TROT_INT n, TrotListNode **node_A );
+static TROT_RC nodeMakeRun( TrotProgram *program, TrotListActual *la, TrotListNode **node );
+static TROT_RC nodeSplitRun( TrotProgram *program, TrotListActual *la, TrotListNode *node, TROT_INT i );
+
+static TROT_INT sameKind( TrotListNode *a, TrotListNode *b );
+static TROT_INT canMix( TrotListNode *node );
+static TROT_RC nodeMakeMixed( TrotProgram *program, TrotListActual *la, TrotListNode **node );
+static TROT_RC mixedInsert( TrotProgram *program, TrotListActual *la, TrotListNode *node, TROT_INT i, TROT_INT n, TrotList *l );
+static TROT_RC mixedReplace( TrotProgram *program, TrotListActual *la, TrotListNode *node, TROT_INT i, TROT_INT n, TrotList *l );
+static void mixedRemove( TrotListNode *node, TROT_INT i );
+static void freeSlots( TrotProgram *program, TrotListSlot *slots, TROT_INT count );
+static TrotList *nodeListAt( TrotListNode *node, TROT_INT i );
+
+static void findNodeInIndex( TrotListActual *la, TROT_INT index, TrotListNode **node, TROT_INT *count );
+static void nodeAddCount( TrotListActual *la, TrotListNode *node, TROT_INT delta );
+static TROT_RC linkNode( TrotProgram *program, TrotListActual *la, TrotListNode *prevNode, TrotListNode *node );
+
+static void indexSetChild( TrotListIndexNode *in, TROT_INT slot, void *child, TROT_INT count );
+static void indexInsert( TrotListActual *la, TrotListIndexNode *in, TROT_INT slot, void *child, TROT_INT count, TrotListIndexNode **spares );
+static void indexAddCount( TrotListIndexNode *in, TROT_INT slot, TROT_INT delta );
+static void indexRemoveNode( TrotProgram *program, TrotListActual *la, TrotListNode *node );
+static TROT_RC indexAllocSpares( TrotProgram *program, TrotListIndexNode *in, TrotListIndexNode **spares );
+static void indexFreeSpares( TrotProgram *program, TrotListIndexNode **spares );
+static void indexShrinkRoot( TrotProgram *program, TrotListActual *la );
+static TROT_RC indexJoin( TrotProgram *program, TrotListActual *la, TrotListActual *laFrom );
+static TROT_RC indexSplit( TrotProgram *program, TrotListActual *la, TrotListActual *newLa, TrotListNode *node );
+static void indexFree( TrotProgram *program, TrotListIndexNode *in );
+
+static void refListAdd( TrotProgram *program, TrotListActual *la, TrotList *l );
 static void refListRemove( TrotProgram *program, TrotListActual *la, TrotList *l );
+static void refFree( TrotProgram *program, TrotList *l );
+static void refSetParent( TrotList *l, TrotListActual *laParent );
+static void refLink( TrotListActual *la, TrotList *l );
+static void refUnlink( TrotListActual *la, TrotList *l );
+static TROT_INT refListHasClient( TrotListActual *la );
+
+static void gcShade( TrotProgram *program, TrotListActual *la );
+static TROT_INT gcScan( TrotProgram *program, TrotListActual *la );
+static TROT_INT gcFreeData( TrotProgram *program, TrotListActual *la );
+static void gcFreeList( TrotProgram *program, TrotListActual *la );
 
 static void isListReachable( TrotListActual *la );
+static void isListReferenced( TrotProgram *program, TrotListActual *la );
+static void gcPossibleRoot( TrotProgram *program, TrotListActual *la );
+static TROT_INT gcHeldFromOutside( TrotListActual *la );
 static TROT_INT findNextParent( TrotListActual *la, TROT_INT queryVisited, TrotListActual **parent );
 
 /******************************************************************************/
@@ -78,12 +151,8 @@ TROT_RC trotListInit( TrotProgram *program, TrotList **l_A )
 	/* DATA */
 	TROT_RC rc = TROT_RC_SUCCESS;
 
-	TrotListNode *newHead = NULL;
-	TrotListNode *newTail = NULL;
 	TrotListActual *newLa = NULL;
 
-	TrotList *newL = NULL;
-
 
 	/* PRECOND */
 	FAILURE_POINT;
@@ -93,65 +162,49 @@ TROT_RC trotListInit( TrotProgram *program, TrotList **l_A )
 
 
 	/* CODE */
-	/* create the data list */
-	TROT_CALLOC( newHead, 1 );
-	TROT_CALLOC( newTail, 1 );
-
-	newHead->prev = newHead;
-	newHead->next = newTail;
-
-	newTail->prev = newHead;
-	newTail->next = newTail;
+	/* look for garbage cycles once enough lists might be in one. we do it
+	   here because every list is in one piece between calls */
+	if (    program->gcMode == TROT_GC_CYCLES
+	     && program->gcRootsCount >= TROT_GC_ROOTS
+	   )
+	{
+		trotListCollectCycles( program );
+	}
 
-	/* create actual list structure */
+	/* create actual list structure, which holds the sentinels and the first
+	   ref too */
 	TROT_CALLOC( newLa, 1 );
 
 	newLa->reachable = 1;
 
-	newLa->head = newHead;
-	newLa->tail = newTail;
-	newHead = NULL;
-	newTail = NULL;
+	/* when collecting in batches, the collector needs to find every list */
+	if ( program->gcMode == TROT_GC_DEFERRED )
+	{
+		newLa->heapNext = program->heap;
+		program->heap = newLa;
 
-	/* create the first ref to this list */
-	TROT_CALLOC( newL, 1 );
+		/* new lists are marked, so a collection under way keeps them */
+		newLa->flagVisited = program->gcEpoch;
+	}
+
+	/* create the data list */
+	newLa->headNode.next = &( newLa->headNode );
+	newLa->last = &( newLa->headNode );
 
-	newL->laPointsTo = newLa;
-	newLa = NULL;
+	/* create the first ref to this list */
+	newLa->firstRef.laPointsTo = newLa;
 
 	/* add first ref to list's ref list */
-	rc = refListAdd( program, newL->laPointsTo, newL );
-	ERR_IF_PASSTHROUGH;
+	newLa->firstRef.refPrev = &( newLa->firstRef );
+	newLa->refList = &( newLa->firstRef );
 
 	/* give back */
-	(*l_A) = newL;
-	newL = NULL;
-
-	/* special case where we return success here instead of going through cleanup. */
-	return TROT_RC_SUCCESS;
+	(*l_A) = &( newLa->firstRef );
 
 
 	/* CLEANUP */
 	cleanup:
 
-	TROT_FREE( newHead, 1 );
-	TROT_FREE( newTail, 1 );
-	if ( newLa != NULL )
-	{
-		TROT_FREE( newLa->refList, 1 );
-		TROT_FREE( newLa->head, 1 );
-		TROT_FREE( newLa->tail, 1 );
-		TROT_FREE( newLa, 1 );
-	}
-	if ( newL != NULL )
-	{
-		TROT_FREE( newL->laPointsTo->refList, 1 );
-		TROT_FREE( newL->laPointsTo->head, 1 );
-		TROT_FREE( newL->laPointsTo->tail, 1 );
-		TROT_FREE( newL->laPointsTo, 1 );
-		TROT_FREE( newL, 1 );
-	}
-
 	return rc;
 }
 
@@ -185,8 +238,7 @@ TROT_RC trotListTwin( TrotProgram *program, TrotList *l, TrotList **l_A )
 	newL->laParent = NULL;
 	newL->laPointsTo = l->laPointsTo;
 
-	rc = refListAdd( program, newL->laPointsTo, newL );
-	ERR_IF_PASSTHROUGH;
+	refListAdd( program, newL->laPointsTo, newL );
 
 
 	/* give back */
@@ -220,8 +272,10 @@ void trotListFree( TrotProgram *program, TrotList **l_F )
 	TrotListActual *la = NULL;
 
 	TrotListNode *node = NULL;
+	TrotListNode *nextNode = NULL;
 
 	TROT_INT j = 0;
+	TrotList **ref = NULL;
 	TrotListActual *laTemp = NULL;
 
 	TrotListActual *laNext = NULL;
@@ -244,11 +298,27 @@ void trotListFree( TrotProgram *program, TrotList **l_F )
 	refListRemove( program, la, (*l_F) );
 
 	/* free ref */
-	TROT_FREE( (*l_F), 1 );
+	refFree( program, (*l_F) );
 	(*l_F) = NULL;
 
+	/* when collecting in batches, trotListCollect frees the list later if
+	   it's no longer reachable */
+	if ( program->gcMode == TROT_GC_DEFERRED )
+	{
+		program->gcFrees += 1;
+		return;
+	}
+
 	/* is list reachable? */
-	isListReachable( la );
+	if ( program->gcMode == TROT_GC_CYCLES )
+	{
+		isListReferenced( program, la );
+	}
+	else
+	{
+		isListReachable( la );
+	}
+
 	if ( la->reachable )
 	{
 		return;
@@ -261,49 +331,66 @@ void trotListFree( TrotProgram *program, TrotList **l_F )
 	while ( laCurrent != NULL )
 	{
 		/* free data */
-		node = laCurrent->head->next;
-		while ( node != laCurrent->tail )
+		node = laCurrent->headNode.next;
+		while ( node != &( laCurrent->headNode ) )
 		{
-			if ( node->n != NULL )
+			if ( node->kind == NODE_KIND_INT )
 			{
-				PARANOID_ERR_IF( node->l != NULL );
-
-				TROT_FREE( node->n, TROT_NODE_SIZE );
+				/* nothing to free but the node */
 			}
 			else
 			{
-				PARANOID_ERR_IF( node->n != NULL );
-				PARANOID_ERR_IF( node->l == NULL );
+				PARANOID_ERR_IF( node->kind != NODE_KIND_LIST && node->kind != NODE_KIND_MIXED );
 
 				for ( j = 0; j < node->count; j += 1 )
 				{
-					laTemp = node->l[ j ]->laPointsTo;
+					if ( node->kind == NODE_KIND_LIST )
+					{
+						ref = &( NODE_LISTS( node )[ j ] );
+					}
+					else if ( NODE_SLOTS( node )[ j ].kind == NODE_KIND_LIST )
+					{
+						ref = &( NODE_SLOTS( node )[ j ].u.l );
+					}
+					else
+					{
+						continue;
+					}
+
+					laTemp = (*ref)->laPointsTo;
 			
-					refListRemove( program, laTemp, node->l[ j ] );
+					refListRemove( program, laTemp, (*ref) );
 
-					TROT_FREE( node->l[ j ], 1 );
-					node->l[ j ] = NULL;
+					refFree( program, (*ref) );
+					(*ref) = NULL;
 
 					if ( laTemp->reachable == 1 )
 					{
-						isListReachable( laTemp );
+						if ( program->gcMode == TROT_GC_CYCLES )
+						{
+							isListReferenced( program, laTemp );
+						}
+						else
+						{
+							isListReachable( laTemp );
+						}
+
 						if ( laTemp->reachable == 0 )
 						{
 							/* need to free this list too */
-							laTemp->nextToFree = laCurrent->nextToFree;
-							laCurrent->nextToFree = laTemp;
+							laTemp->link.nextToFree = laCurrent->link.nextToFree;
+							laCurrent->link.nextToFree = laTemp;
 						}
 					}
 				}
-
-				TROT_FREE( node->l, TROT_NODE_SIZE );
 			}
 
-			node = node->next;
-			TROT_FREE( node->prev, 1 );
+			nextNode = node->next;
+			nodeFree( program, laCurrent, node );
+			node = nextNode;
 		}
 
-		laCurrent = laCurrent->nextToFree;
+		laCurrent = laCurrent->link.nextToFree;
 	}
 
 	/* *** */
@@ -314,18 +401,397 @@ void trotListFree( TrotProgram *program, TrotList **l_F )
 		laCurrent = laNext;
 
 		/* *** */
-		laNext = laNext->nextToFree;
+		laNext = laNext->link.nextToFree;
 
 		/* *** */
-		TROT_FREE( laCurrent->head, 1 );
-		TROT_FREE( laCurrent->tail, 1 );
-		TROT_FREE( laCurrent->refList, 1 );
+		PARANOID_ERR_IF( laCurrent->refList != NULL );
+
+		/* the cycle collector frees lists that are still in gcRoots */
+		if ( laCurrent->flagBuffered )
+		{
+			laCurrent->flagVisited = GC_COLOR_BLACK;
+			continue;
+		}
+
+		indexFree( program, laCurrent->indexRoot );
 		TROT_FREE( laCurrent, 1 );
 	}
 
 	return;
 }
 
+/******************************************************************************/
+/*!
+	\brief Frees every list in the program's heap that can't be reached from a
+		client ref. This is how lists get freed when the program's gcMode is
+		TROT_GC_DEFERRED, instead of trotListFree checking each time a ref is
+		freed.
+	\param[in] program Program to collect garbage in.
+	\return void
+
+	If a collection is already under way, it's finished first, since lists it
+	marked may have become garbage since.
+*/
+void trotListCollect( TrotProgram *program )
+{
+	/* CODE */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( program->gcMode != TROT_GC_DEFERRED );
+
+	if ( program->gcPhase != GC_PHASE_IDLE )
+	{
+		while ( trotListCollectStep( program, TROT_INT_MAX ) == 0 )
+		{
+			/* keep going */
+		}
+	}
+
+	while ( trotListCollectStep( program, TROT_INT_MAX ) == 0 )
+	{
+		/* keep going */
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Does some of the work of collecting garbage.
+	\param[in] program Program to collect garbage in.
+	\param[in] budget About how much work to do. A list and an item in a
+		list are each one unit of work.
+	\return 1 if this step finished a collection, 0 if not.
+
+	Starts a new collection if one isn't under way. Lists with a client ref
+	are marked, then everything they hold is marked, using link.nextToFree as
+	the stack. Lists that weren't marked are taken out of the heap, and freed
+	in two passes: first their data, so refs to lists that are still
+	reachable come out of those lists' refLists, then the lists themselves.
+
+	The client can change lists between steps. While marking, any list that
+	gets a new ref, is given back to the client, or moves to another list is
+	marked too, so a list can't hide from the collector. New lists start out
+	marked. Whole lists are marked and freed at a time, so a step can go over
+	budget by one list.
+*/
+TROT_INT trotListCollectStep( TrotProgram *program, TROT_INT budget )
+{
+	/* DATA */
+	TROT_INT work = 0;
+
+	TrotListActual *la = NULL;
+
+
+	/* CODE */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( program->gcMode != TROT_GC_DEFERRED );
+
+	if ( program->gcPhase == GC_PHASE_IDLE )
+	{
+		/* lists marked last time now count as unmarked */
+		program->gcEpoch = ( program->gcEpoch == 1 ) ? 2 : 1;
+		program->gcFrees = 0;
+		program->gcCursor = program->heap;
+		program->gcPhase = GC_PHASE_ROOTS;
+	}
+
+	do
+	{
+		switch ( program->gcPhase )
+		{
+			case GC_PHASE_ROOTS:
+				la = program->gcCursor;
+				if ( la == NULL )
+				{
+					program->gcPhase = GC_PHASE_MARK;
+					break;
+				}
+
+				program->gcCursor = la->heapNext;
+				work += 1;
+
+				/* mark lists that have a client ref */
+				if ( refListHasClient( la ) )
+				{
+					gcShade( program, la );
+				}
+
+				break;
+
+			case GC_PHASE_MARK:
+				la = program->gcStack;
+				if ( la == NULL )
+				{
+					program->gcSweep = &( program->heap );
+					program->gcPhase = GC_PHASE_SWEEP;
+					break;
+				}
+
+				program->gcStack = la->link.nextToFree;
+				la->link.nextToFree = NULL;
+
+				/* mark everything it holds */
+				work += gcScan( program, la );
+
+				break;
+
+			case GC_PHASE_SWEEP:
+				la = (*program->gcSweep);
+				if ( la == NULL )
+				{
+					program->gcCursor = program->gcGarbage;
+					program->gcPhase = GC_PHASE_FREE_DATA;
+					break;
+				}
+
+				work += 1;
+
+				/* take lists that weren't marked out of the heap */
+				if ( la->flagVisited == program->gcEpoch )
+				{
+					program->gcSweep = &( la->heapNext );
+				}
+				else
+				{
+					(*program->gcSweep) = la->heapNext;
+
+					la->reachable = 0;
+					la->link.nextToFree = program->gcGarbage;
+					program->gcGarbage = la;
+				}
+
+				break;
+
+			case GC_PHASE_FREE_DATA:
+				la = program->gcCursor;
+				if ( la == NULL )
+				{
+					program->gcPhase = GC_PHASE_FREE_LISTS;
+					break;
+				}
+
+				program->gcCursor = la->link.nextToFree;
+
+				work += gcFreeData( program, la );
+
+				break;
+
+			case GC_PHASE_FREE_LISTS:
+				la = program->gcGarbage;
+				if ( la == NULL )
+				{
+					program->gcSweep = NULL;
+					program->gcPhase = GC_PHASE_IDLE;
+					return 1;
+				}
+
+				program->gcGarbage = la->link.nextToFree;
+				work += 1;
+
+				gcFreeList( program, la );
+
+				break;
+
+			default:
+				PARANOID_ERR_IF( 1 );
+				break;
+		}
+	}
+	while ( work < budget );
+
+	return 0;
+}
+
+/******************************************************************************/
+/*!
+	\brief Frees lists in the program's gcRoots that turn out to only be held
+		by each other. This is how garbage cycles get freed when the
+		program's gcMode is TROT_GC_CYCLES.
+	\param[in] program Program to collect garbage in.
+	\return void
+
+	Lists that lost a ref, but still have refs, are put in gcRoots. This
+	takes them out and marks them and everything they hold gray, using
+	heapNext to keep the gray lists in order. A gray list with a ref that
+	isn't in a gray list is held from outside, so it and everything it
+	holds are marked black. Lists still gray are garbage, and are freed like
+	trotListCollect frees them.
+*/
+void trotListCollectCycles( TrotProgram *program )
+{
+	/* DATA */
+	TrotListActual *la = NULL;
+	TrotListActual *laNext = NULL;
+	TrotListActual *laChild = NULL;
+
+	TrotListActual *gray = NULL;
+	TrotListActual *grayLast = NULL;
+	TrotListActual *stack = NULL;
+	TrotListActual *black = NULL;
+	TrotListActual *garbage = NULL;
+
+	TrotListNode *node = NULL;
+
+	TROT_INT j = 0;
+	TrotList *ref = NULL;
+
+
+	/* CODE */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( program->gcMode != TROT_GC_CYCLES );
+
+	/* take lists out of gcRoots. the ones still purple are where we start */
+	while ( program->gcRoots != NULL )
+	{
+		la = program->gcRoots;
+		program->gcRoots = la->heapNext;
+		la->heapNext = NULL;
+		la->flagBuffered = 0;
+
+		if ( la->reachable == 0 )
+		{
+			/* it lost all its refs while it was waiting, and trotListFree
+			   left it for us */
+			gcFreeList( program, la );
+		}
+		else if ( la->flagVisited == GC_COLOR_PURPLE )
+		{
+			la->flagVisited = GC_COLOR_GRAY;
+
+			if ( grayLast == NULL )
+			{
+				gray = la;
+			}
+			else
+			{
+				grayLast->heapNext = la;
+			}
+			grayLast = la;
+		}
+	}
+
+	program->gcRootsCount = 0;
+
+	/* mark everything they hold gray */
+	la = gray;
+	while ( la != NULL )
+	{
+		node = la->headNode.next;
+		while ( node != &( la->headNode ) )
+		{
+			if ( node->kind != NODE_KIND_INT )
+			{
+				for ( j = 0; j < node->count; j += 1 )
+				{
+					ref = nodeListAt( node, j );
+					if ( ref == NULL )
+					{
+						continue;
+					}
+
+					laChild = ref->laPointsTo;
+					if ( laChild->flagVisited != GC_COLOR_GRAY )
+					{
+						laChild->flagVisited = GC_COLOR_GRAY;
+						laChild->heapNext = NULL;
+
+						grayLast->heapNext = laChild;
+						grayLast = laChild;
+					}
+				}
+			}
+
+			node = node->next;
+		}
+
+		la = la->heapNext;
+	}
+
+	/* mark gray lists that are held from outside, and everything they
+	   hold, black */
+	la = gray;
+	while ( la != NULL )
+	{
+		if ( la->flagVisited == GC_COLOR_GRAY && gcHeldFromOutside( la ) )
+		{
+			la->flagVisited = GC_COLOR_BLACK;
+			la->link.nextToFree = NULL;
+			stack = la;
+
+			while ( stack != NULL )
+			{
+				black = stack;
+				stack = black->link.nextToFree;
+				black->link.nextToFree = NULL;
+
+				node = black->headNode.next;
+				while ( node != &( black->headNode ) )
+				{
+					if ( node->kind != NODE_KIND_INT )
+					{
+						for ( j = 0; j < node->count; j += 1 )
+						{
+							ref = nodeListAt( node, j );
+							if ( ref == NULL )
+							{
+								continue;
+							}
+
+							laChild = ref->laPointsTo;
+							if ( laChild->flagVisited != GC_COLOR_BLACK )
+							{
+								laChild->flagVisited = GC_COLOR_BLACK;
+								laChild->link.nextToFree = stack;
+								stack = laChild;
+							}
+						}
+					}
+
+					node = node->next;
+				}
+			}
+		}
+
+		la = la->heapNext;
+	}
+
+	/* lists still gray are only held by each other */
+	la = gray;
+	while ( la != NULL )
+	{
+		laNext = la->heapNext;
+		la->heapNext = NULL;
+
+		if ( la->flagVisited == GC_COLOR_GRAY )
+		{
+			la->flagVisited = GC_COLOR_BLACK;
+			la->reachable = 0;
+			la->link.nextToFree = garbage;
+			garbage = la;
+		}
+
+		la = laNext;
+	}
+
+	/* free their data, then the lists */
+	la = garbage;
+	while ( la != NULL )
+	{
+		gcFreeData( program, la );
+		la = la->link.nextToFree;
+	}
+
+	while ( garbage != NULL )
+	{
+		la = garbage;
+		garbage = la->link.nextToFree;
+
+		gcFreeList( program, la );
+	}
+
+	return;
+}
+
 /******************************************************************************/
 /*!
 	\brief Compares list references to see if they point to the same list.
@@ -430,28 +896,9 @@ TROT_RC trotListGetKind( TrotProgram *program, TrotList *l, TROT_INT index, TROT
 	ERR_IF_1( index > (la->childrenCount ), TROT_RC_ERROR_BAD_INDEX, index );
 
 	/* *** */
-	node = la->head->next;
-	while ( 1 )
-	{
-		count += node->count;
-		if ( count >= index )
-		{
-			break;
-		}
-
-		node = node->next;
-
-		PARANOID_ERR_IF( node == la->tail );
-	}
+	trotListFindNode( la, index, &node, &count );
 
-	if ( node->n != NULL )
-	{
-		(*kind) = NODE_KIND_INT;
-	}
-	else
-	{
-		(*kind) = NODE_KIND_LIST;
-	}
+	(*kind) = trotListNodeGetKind( node, index - count - 1 );
 
 	return TROT_RC_SUCCESS;
 
@@ -492,21 +939,61 @@ TROT_RC trotListAppendInt( TrotProgram *program, TrotList *l, TROT_INT n )
 	ERR_IF( TROT_MAX_CHILDREN - la->childrenCount < 1, TROT_RC_ERROR_LIST_OVERFLOW );
 
 	/* *** */
-	node = la->tail->prev;
+	node = la->last;
 
-	/* special cases to create new node */
-	if (    node == la->head             /* empty list */
-	     || node->n == NULL /* last node is not int kind */
-	     || node->count == TROT_NODE_SIZE    /* last node is full */
+	/* the inline node moves into a bigger normal node when it fills up */
+	if (    node == &( la->inlineNode )
+	     && node->count == node->capacity
+	     && node->capacity < TROT_NODE_SIZE
 	   )
 	{
-		rc = newIntNode( program, la->tail, n );
+		rc = nodeRealloc( program, la, &node );
+		ERR_IF_PASSTHROUGH;
+	}
+
+	/* if last node is a run of n, it just gets longer */
+	if ( nodeIsRun( node ) && NODE_GET_INT( node, 0 ) == n )
+	{
+		nodeAddCount( la, node, 1 );
+	}
+	/* if last node is full of n, it becomes a run of n */
+	else if (    node != &( la->headNode )
+	          && node->kind == NODE_KIND_INT
+	          && node->count == node->capacity
+	          && nodeIsAll( node, n )
+	        )
+	{
+		rc = nodeMakeRun( program, la, &node );
+		ERR_IF_PASSTHROUGH;
+
+		nodeAddCount( la, node, 1 );
+	}
+	/* if last node can hold mixed kinds, append there */
+	else if (    node != &( la->headNode )
+	          && node->kind != NODE_KIND_INT
+	          && node->count != node->capacity
+	          && canMix( node )
+	        )
+	{
+		rc = mixedInsert( program, la, node, node->count, n, NULL );
+		ERR_IF_PASSTHROUGH;
+	}
+	/* special cases to create new node */
+	else if (    node == &( la->headNode )             /* empty list */
+	          || node->kind != NODE_KIND_INT /* last node is not int kind */
+	          || node->count == node->capacity    /* last node is full */
+	        )
+	{
+		rc = newIntNode( program, la, &( la->headNode ), n );
 		ERR_IF_PASSTHROUGH;
 	}
 	else
 	{
-		node->n[ node->count ] = n;
-		node->count += 1;
+		rc = nodeWiden( program, la, &node, intWidth( n ) );
+		ERR_IF_PASSTHROUGH;
+
+		nodeSetInt( node, node->count, n );
+		nodeAddCount( la, node, 1 );
 	}
 
 
@@ -554,16 +1041,35 @@ TROT_RC trotListAppendList( TrotProgram *program, TrotList *l, TrotList *lToAppe
 	ERR_IF( TROT_MAX_CHILDREN - la->childrenCount < 1, TROT_RC_ERROR_LIST_OVERFLOW );
 
 	/* *** */
-	node = la->tail->prev;
+	node = la->last;
 
-
-	/* special cases to create new node */
-	if (    node == la->head              /* empty list */
-	     || node->l == NULL /* last node is not list kind */
-	     || node->count == TROT_NODE_SIZE     /* last node is full */
+	/* the inline node moves into a bigger normal node when it fills up */
+	if (    node == &( la->inlineNode )
+	     && node->count == node->capacity
+	     && node->capacity < TROT_NODE_SIZE
 	   )
 	{
-		rc = newListNode( program, la, la->tail, lToAppend );
+		rc = nodeRealloc( program, la, &node );
+		ERR_IF_PASSTHROUGH;
+	}
+
+	/* if last node can hold mixed kinds, append there */
+	if (    node != &( la->headNode )
+	     && node->kind != NODE_KIND_LIST
+	     && node->count != node->capacity
+	     && canMix( node )
+	   )
+	{
+		rc = mixedInsert( program, la, node, node->count, 0, lToAppend );
+		ERR_IF_PASSTHROUGH;
+	}
+	/* special cases to create new node */
+	else if (    node == &( la->headNode )              /* empty list */
+	          || node->kind != NODE_KIND_LIST /* last node is not list kind */
+	          || node->count == node->capacity     /* last node is full */
+	        )
+	{
+		rc = newListNode( program, la, &( la->headNode ), lToAppend );
 		ERR_IF_PASSTHROUGH;
 	}
 	else
@@ -573,11 +1079,11 @@ TROT_RC trotListAppendList( TrotProgram *program, TrotList *l, TrotList *lToAppe
 		ERR_IF_PASSTHROUGH;
 
 		/* append */
-		node->l[ node->count ] = newL;
-		newL->laParent = la;
+		NODE_LISTS( node )[ node->count ] = newL;
+		refSetParent( newL, la );
 		newL = NULL;
 
-		node->count += 1;
+		nodeAddCount( la, node, 1 );
 	}
 
 	la->childrenCount += 1;
@@ -606,11 +1112,11 @@ TROT_RC trotListInsertInt( TrotProgram *program, TrotList *l, TROT_INT index, TR
 	TrotListActual *la = NULL;
 
 	TrotListNode *node = NULL;
+	TrotListNode *prevNode = NULL;
 
 	TROT_INT count = 0;
 
 	TROT_INT i = 0;
-	TROT_INT j = 0;
 
 
 	/* PRECOND */
@@ -646,27 +1152,34 @@ TROT_RC trotListInsertInt( TrotProgram *program, TrotList *l, TROT_INT index, TR
 	ERR_IF_1( index > (la->childrenCount), TROT_RC_ERROR_BAD_INDEX, index );
 
 	/* Find node where int needs to be added into */
-	node = la->head->next;
-	while ( 1 )
+	trotListFindNode( la, index, &node, &count );
+
+	/* *** */
+	if ( node->kind == NODE_KIND_INT )
 	{
-		if ( count + (node->count) >= index )
+		/* a run of n just gets longer, else the part of the run where n
+		   goes has to be a normal node first */
+		if ( nodeIsRun( node ) )
 		{
-			break;
-		}
+			if ( NODE_GET_INT( node, 0 ) == n )
+			{
+				nodeAddCount( la, node, 1 );
 
-		count += node->count;
-		node = node->next;
+				la->childrenCount += 1;
 
-		PARANOID_ERR_IF( node == la->tail );
-	}
+				return TROT_RC_SUCCESS;
+			}
+
+			rc = nodeSplitRun( program, la, node, index - count - 1 );
+			ERR_IF_PASSTHROUGH;
+
+			trotListFindNode( la, index, &node, &count );
+		}
 
-	/* *** */
-	if ( node->n != NULL )
-	{
 		/* If node is full */
-		if ( node->count == TROT_NODE_SIZE )
+		if ( node->count == node->capacity )
 		{
-			rc = trotListNodeSplit( program, node, TROT_NODE_SIZE / 2 );
+			rc = nodeMakeRoom( program, la, &node );
 			ERR_IF_PASSTHROUGH;
 
 			/* Since node has been split, we may need to go to next
@@ -681,57 +1194,74 @@ TROT_RC trotListInsertInt( TrotProgram *program, TrotList *l, TROT_INT index, TR
 		/* We now have the node where the int needs to be inserted.
 		   We've made sure there is space to insert.
 		   (count + 1) is the beginning index of the node */
+		rc = nodeWiden( program, la, &node, intWidth( n ) );
+		ERR_IF_PASSTHROUGH;
+
 		/* Now let's move any ints over to make room */
 		i = index - count - 1;
-		j = node->count;
-		while ( j != i )
-		{
-			node->n[ j ] = node->n[ j - 1 ];
-			j -= 1;
-		}
+		copyInts( node, i + 1, node, i, (node->count) - i );
 
 		/* Insert int into node */
-		node->n[ i ] = n;
-		node->count += 1;
+		nodeSetInt( node, i, n );
+		nodeAddCount( la, node, 1 );
 
 		la->childrenCount += 1;
 
 		return TROT_RC_SUCCESS;
 	}
-	else /* node is list kind */
+	else /* node is list or mixed kind */
 	{
 		i = index - count - 1;
 
 		/* If we need to insert at spot 0, we see if the previous node
 		   is an int node with room. If so, we can just append to that
 		   node. */
-		if (    i == 0
-		     && node->prev->n != NULL
-		     && node->prev->count != TROT_NODE_SIZE 
+		if ( i == 0 )
+		{
+			prevNode = trotListNodePrev( la, node );
+		}
+
+		if (    prevNode != NULL
+		     && prevNode->kind == NODE_KIND_INT
+		     && prevNode->count != prevNode->capacity
 		   )
 		{
-			node = node->prev;
+			node = prevNode;
+
+			rc = nodeWiden( program, la, &node, intWidth( n ) );
+			ERR_IF_PASSTHROUGH;
 
 			/* Insert int into node */
-			node->n[ node->count ] = n;
-			node->count += 1;
+			nodeSetInt( node, node->count, n );
+			nodeAddCount( la, node, 1 );
 
 			la->childrenCount += 1;
 
 			return TROT_RC_SUCCESS; /* TODO: we need to get rid of early returns */
 		}
 
+		/* If node can hold mixed kinds, we can insert right into it. */
+		if ( canMix( node ) )
+		{
+			rc = mixedInsert( program, la, node, i, n, NULL );
+			ERR_IF_PASSTHROUGH;
+
+			la->childrenCount += 1;
+
+			return TROT_RC_SUCCESS;
+		}
+
 		/* if not at beginning, we'll have to split the node */
 		if ( i != 0 )
 		{
-			rc = trotListNodeSplit( program, node, i );
+			rc = trotListNodeSplit( program, la, node, i );
 			ERR_IF_PASSTHROUGH;
 
 			node = node->next;
 		}
 
 		/* *** */
-		rc = newIntNode( program, node, n );
+		rc = newIntNode( program, la, node, n );
 		ERR_IF_PASSTHROUGH;
 
 		la->childrenCount += 1;
@@ -763,6 +1293,7 @@ TROT_RC trotListInsertList( TrotProgram *program, TrotList *l, TROT_INT index, T
 	TrotListActual *la = NULL;
 
 	TrotListNode *node = NULL;
+	TrotListNode *prevNode = NULL;
 
 	TROT_INT count = 0;
 
@@ -805,29 +1336,16 @@ TROT_RC trotListInsertList( TrotProgram *program, TrotList *l, TROT_INT index, T
 	ERR_IF_1( index <= 0, TROT_RC_ERROR_BAD_INDEX, index );
 	ERR_IF_1( index > (la->childrenCount ), TROT_RC_ERROR_BAD_INDEX, index );
 
-	/* FUTURE: factor this out into a function, maybe include index check above too */
 	/* Find node where list needs to be added into */
-	node = la->head->next;
-	while ( 1 )
-	{
-		if ( count + (node->count) >= index )
-		{
-			break;
-		}
-
-		count += node->count;
-		node = node->next;
-
-		PARANOID_ERR_IF( node == la->tail );
-	}
+	trotListFindNode( la, index, &node, &count );
 
 	/* *** */
-	if ( node->l != NULL )
+	if ( node->kind == NODE_KIND_LIST )
 	{
 		/* If node is full */
-		if ( node->count == TROT_NODE_SIZE )
+		if ( node->count == node->capacity )
 		{
-			rc = trotListNodeSplit( program, node, TROT_NODE_SIZE / 2 );
+			rc = nodeMakeRoom( program, la, &node );
 			ERR_IF_PASSTHROUGH;
 
 			/* Since node has been split, we may need to go to next
@@ -852,44 +1370,60 @@ TROT_RC trotListInsertList( TrotProgram *program, TrotList *l, TROT_INT index, T
 		j = node->count;
 		while ( j != i )
 		{
-			node->l[ j ] = node->l[ j - 1 ];
+			NODE_LISTS( node )[ j ] = NODE_LISTS( node )[ j - 1 ];
 			j -= 1;
 		}
 
 		/* Insert list into node */
-		node->l[ i ] = newL;
-		newL->laParent = la;
+		NODE_LISTS( node )[ i ] = newL;
+		refSetParent( newL, la );
 		newL = NULL;
 
-		node->count += 1;
+		nodeAddCount( la, node, 1 );
 
 		la->childrenCount += 1;
 
 		return TROT_RC_SUCCESS;
 	}
-	else /* node is int kind */
+	else /* node is int or mixed kind */
 	{
 		i = index - count - 1;
 
 		/* If we need to insert at spot 0, we see if the previous node
 		   is an list node with room. If so, we can just append to that
 		   node. */
-		if (    i == 0
-		     && node->prev->l != NULL
-		     && node->prev->count != TROT_NODE_SIZE 
+		if ( i == 0 )
+		{
+			prevNode = trotListNodePrev( la, node );
+		}
+
+		if (    prevNode != NULL
+		     && prevNode->kind == NODE_KIND_LIST
+		     && prevNode->count != prevNode->capacity
 		   )
 		{
-			node = node->prev;
+			node = prevNode;
 
 			/* Insert list into node */
 			rc = trotListTwin( program, lToInsert, &newL );
 			ERR_IF_PASSTHROUGH;
 
-			node->l[ node->count ] = newL;
-			newL->laParent = la;
+			NODE_LISTS( node )[ node->count ] = newL;
+			refSetParent( newL, la );
 			newL = NULL;
 
-			node->count += 1;
+			nodeAddCount( la, node, 1 );
+
+			la->childrenCount += 1;
+
+			return TROT_RC_SUCCESS;
+		}
+
+		/* If node can hold mixed kinds, we can insert right into it. */
+		if ( canMix( node ) )
+		{
+			rc = mixedInsert( program, la, node, i, 0, lToInsert );
+			ERR_IF_PASSTHROUGH;
 
 			la->childrenCount += 1;
 
@@ -899,7 +1433,7 @@ TROT_RC trotListInsertList( TrotProgram *program, TrotList *l, TROT_INT index, T
 		/* if not at beginning, we'll have to split the node */
 		if ( i != 0 )
 		{
-			rc = trotListNodeSplit( program, node, i );
+			rc = trotListNodeSplit( program, la, node, i );
 			ERR_IF_PASSTHROUGH;
 
 			node = node->next;
@@ -965,24 +1499,19 @@ TROT_RC trotListGetInt( TrotProgram *program, TrotList *l, TROT_INT index, TROT_
 	ERR_IF_1( index > (la->childrenCount ), TROT_RC_ERROR_BAD_INDEX, index );
 
 	/* *** */
-	node = la->head->next;
-	while ( 1 )
-	{
-		count += node->count;
-		if ( count >= index )
-		{
-			break;
-		}
-
-		node = node->next;
+	trotListFindNode( la, index, &node, &count );
 
-		PARANOID_ERR_IF( node == la->tail );
-	}
-
-	ERR_IF( node->n == NULL, TROT_RC_ERROR_WRONG_KIND );
+	ERR_IF( trotListNodeGetKind( node, index - count - 1 ) != NODE_KIND_INT, TROT_RC_ERROR_WRONG_KIND );
 
 	/* give back */
-	(*n) = node->n[ (node->count) - 1 - (count - index) ];
+	if ( node->kind == NODE_KIND_INT )
+	{
+		(*n) = NODE_GET_INT( node, index - count - 1 );
+	}
+	else
+	{
+		(*n) = NODE_SLOTS( node )[ index - count - 1 ].u.n;
+	}
 
 	return TROT_RC_SUCCESS;
 
@@ -1034,23 +1563,18 @@ TROT_RC trotListGetList( TrotProgram *program, TrotList *l, TROT_INT index, Trot
 	ERR_IF_1( index > (l->laPointsTo->childrenCount ), TROT_RC_ERROR_BAD_INDEX, index );
 
 	/* *** */
-	node = l->laPointsTo->head->next;
-	while ( 1 )
-	{
-		count += node->count;
-		if ( count >= index )
-		{
-			break;
-		}
+	trotListFindNode( l->laPointsTo, index, &node, &count );
 
-		node = node->next;
+	ERR_IF( trotListNodeGetKind( node, index - count - 1 ) != NODE_KIND_LIST, TROT_RC_ERROR_WRONG_KIND );
 
-		PARANOID_ERR_IF( node == l->laPointsTo->tail );
+	if ( node->kind == NODE_KIND_LIST )
+	{
+		rc = trotListTwin( program, NODE_LISTS( node )[ index - count - 1 ], &newL );
+	}
+	else
+	{
+		rc = trotListTwin( program, NODE_SLOTS( node )[ index - count - 1 ].u.l, &newL );
 	}
-
-	ERR_IF( node->l == NULL, TROT_RC_ERROR_WRONG_KIND );
-
-	rc = trotListTwin( program, node->l[ (node->count) - 1 - (count - index) ], &newL );
 	ERR_IF_PASSTHROUGH;
 
 	/* give back */
@@ -1097,8 +1621,6 @@ TROT_RC trotListRemoveInt( TrotProgram *program, TrotList *l, TROT_INT index, TR
 
 
 	/* CODE */
-	(void)program;
-
 	/* Turn negative index into positive equivalent. */
 	if ( index < 0 )
 	{
@@ -1110,39 +1632,32 @@ TROT_RC trotListRemoveInt( TrotProgram *program, TrotList *l, TROT_INT index, TR
 	ERR_IF_1( index > (l->laPointsTo->childrenCount ), TROT_RC_ERROR_BAD_INDEX, index );
 
 	/* *** */
-	node = l->laPointsTo->head->next;
-	while ( 1 )
-	{
-		count += node->count;
-		if ( count >= index )
-		{
-			break;
-		}
-
-		node = node->next;
+	trotListFindNode( l->laPointsTo, index, &node, &count );
 
-		PARANOID_ERR_IF( node == l->laPointsTo->tail );
-	}
+	i = index - count - 1;
 
-	ERR_IF( node->n == NULL, TROT_RC_ERROR_WRONG_KIND );
+	ERR_IF( trotListNodeGetKind( node, i ) != NODE_KIND_INT, TROT_RC_ERROR_WRONG_KIND );
 
-	i = (node->count) - 1 - (count - index);
-	giveBackN = node->n[ i ];
-	while ( i < ( (node->count) - 1 ) )
+	if ( node->kind == NODE_KIND_INT )
 	{
-		node->n[ i ] = node->n[ i + 1 ];
-		i += 1;
+		giveBackN = NODE_GET_INT( node, i );
+		copyInts( node, i, node, i + 1, (node->count) - i - 1 );
+	}
+	else
+	{
+		giveBackN = NODE_SLOTS( node )[ i ].u.n;
+		mixedRemove( node, i );
 	}
-	node->count -= 1;
+	nodeAddCount( l->laPointsTo, node, -1 );
 	l->laPointsTo->childrenCount -= 1;
 
-	if ( node->count == 0 ) /* FUTURE: this code may be able to be factored out into a function */
+	if ( node->count == 0 )
 	{
-		node->prev->next = node->next;
-		node->next->prev = node->prev;
-
-		TROT_FREE( node->n, TROT_NODE_SIZE );
-		TROT_FREE( node, 1 );
+		removeNode( program, l->laPointsTo, node );
+	}
+	else
+	{
+		nodeMerge( program, l->laPointsTo, node );
 	}
 
 	/* give back */
@@ -1189,8 +1704,6 @@ TROT_RC trotListRemoveList( TrotProgram *program, TrotList *l, TROT_INT index, T
 
 
 	/* CODE */
-	(void)program;
-
 	/* Turn negative index into positive equivalent. */
 	if ( index < 0 )
 	{
@@ -1202,41 +1715,39 @@ TROT_RC trotListRemoveList( TrotProgram *program, TrotList *l, TROT_INT index, T
 	ERR_IF_1( index > (l->laPointsTo->childrenCount ), TROT_RC_ERROR_BAD_INDEX, index );
 
 	/* *** */
-	node = l->laPointsTo->head->next;
-	while ( 1 )
+	trotListFindNode( l->laPointsTo, index, &node, &count );
+
+	i = index - count - 1;
+
+	ERR_IF( trotListNodeGetKind( node, i ) != NODE_KIND_LIST, TROT_RC_ERROR_WRONG_KIND );
+
+	if ( node->kind == NODE_KIND_LIST )
 	{
-		count += node->count;
-		if ( count >= index )
+		giveBackL = NODE_LISTS( node )[ i ];
+		while ( i < ( (node->count) - 1 ) )
 		{
-			break;
+			NODE_LISTS( node )[ i ] = NODE_LISTS( node )[ i + 1 ];
+			i += 1;
 		}
-
-		node = node->next;
-
-		PARANOID_ERR_IF( node == l->laPointsTo->tail );
+		NODE_LISTS( node )[ i ] = NULL;
 	}
-
-	ERR_IF( node->l == NULL, TROT_RC_ERROR_WRONG_KIND );
-
-	i = (node->count) - 1 - (count - index);
-	giveBackL = node->l[ i ];
-	giveBackL->laParent = NULL;
-	while ( i < ( (node->count) - 1 ) )
+	else
 	{
-		node->l[ i ] = node->l[ i + 1 ];
-		i += 1;
+		giveBackL = NODE_SLOTS( node )[ i ].u.l;
+		mixedRemove( node, i );
 	}
-	node->l[ i ] = NULL;
-	node->count -= 1;
+	refSetParent( giveBackL, NULL );
+	gcShade( program, giveBackL->laPointsTo );
+	nodeAddCount( l->laPointsTo, node, -1 );
 	l->laPointsTo->childrenCount -= 1;
 
 	if ( node->count == 0 )
 	{
-		node->prev->next = node->next;
-		node->next->prev = node->prev;
-
-		TROT_FREE( node->l, TROT_NODE_SIZE );
-		TROT_FREE( node, 1 );
+		removeNode( program, l->laPointsTo, node );
+	}
+	else
+	{
+		nodeMerge( program, l->laPointsTo, node );
 	}
 
 	/* give back */
@@ -1291,59 +1802,46 @@ TROT_RC trotListRemove( TrotProgram *program, TrotList *l, TROT_INT index )
 	ERR_IF_1( index > (l->laPointsTo->childrenCount ), TROT_RC_ERROR_BAD_INDEX, index );
 
 	/* *** */
-	node = l->laPointsTo->head->next;
-	while ( 1 )
-	{
-		count += node->count;
-		if ( count >= index )
-		{
-			break;
-		}
-
-		node = node->next;
+	trotListFindNode( l->laPointsTo, index, &node, &count );
 
-		PARANOID_ERR_IF( node == l->laPointsTo->tail );
+	i = index - count - 1;
+	if ( node->kind == NODE_KIND_INT )
+	{
+		copyInts( node, i, node, i + 1, (node->count) - i - 1 );
 	}
-
-	i = (node->count) - 1 - (count - index);
-	if ( node->n != NULL )
+	else if ( node->kind == NODE_KIND_LIST )
 	{
+		tempL = NODE_LISTS( node )[ i ];
+		refSetParent( tempL, NULL );
+		trotListFree( program, &tempL );
 		while ( i < ( (node->count) - 1 ) )
 		{
-			node->n[ i ] = node->n[ i + 1 ];
+			NODE_LISTS( node )[ i ] = NODE_LISTS( node )[ i + 1 ];
 			i += 1;
 		}
+		NODE_LISTS( node )[ i ] = NULL;
 	}
 	else
 	{
-		tempL = node->l[ i ];
-		tempL->laParent = NULL;
-		trotListFree( program, &tempL );
-		while ( i < ( (node->count) - 1 ) )
+		if ( NODE_SLOTS( node )[ i ].kind == NODE_KIND_LIST )
 		{
-			node->l[ i ] = node->l[ i + 1 ];
-			i += 1;
+			tempL = NODE_SLOTS( node )[ i ].u.l;
+			refSetParent( tempL, NULL );
+			trotListFree( program, &tempL );
 		}
-		node->l[ i ] = NULL;
+		mixedRemove( node, i );
 	}
 	
-	node->count -= 1;
+	nodeAddCount( l->laPointsTo, node, -1 );
 	l->laPointsTo->childrenCount -= 1;
 
 	if ( node->count == 0 )
 	{
-		node->prev->next = node->next;
-		node->next->prev = node->prev;
-
-		if ( node->n != NULL )
-		{
-			TROT_FREE( node->n, TROT_NODE_SIZE );
-		}
-		else
-		{
-			TROT_FREE( node->l, TROT_NODE_SIZE );
-		}
-		TROT_FREE( node, 1 );
+		removeNode( program, l->laPointsTo, node );
+	}
+	else
+	{
+		nodeMerge( program, l->laPointsTo, node );
 	}
 
 	return TROT_RC_SUCCESS;
@@ -1372,13 +1870,14 @@ TROT_RC trotListReplaceWithInt( TrotProgram *program, TrotList *l, TROT_INT inde
 	TrotListActual *la = NULL;
 
 	TrotListNode *node = NULL;
+	TrotListNode *prevNode = NULL;
+	TrotListNode *intNode = NULL;
 
 	TROT_INT count = 0;
 
 	TrotList *tempL = NULL;
 
 	TROT_INT i = 0;
-	TROT_INT j = 0;
 
 
 	/* PRECOND */
@@ -1404,27 +1903,36 @@ TROT_RC trotListReplaceWithInt( TrotProgram *program, TrotList *l, TROT_INT inde
 	ERR_IF_1( index > (la->childrenCount), TROT_RC_ERROR_BAD_INDEX, index );
 
 	/* Find node where int needs to be replaced into */
-	node = la->head->next;
-	while ( 1 )
+	trotListFindNode( la, index, &node, &count );
+
+	/* *** */
+	if ( node->kind == NODE_KIND_INT )
 	{
-		if ( count + (node->count) >= index )
+		/* the part of a run that's changing has to be a normal node first */
+		if ( nodeIsRun( node ) && NODE_GET_INT( node, 0 ) != n )
 		{
-			break;
+			rc = nodeSplitRun( program, la, node, index - count - 1 );
+			ERR_IF_PASSTHROUGH;
+
+			trotListFindNode( la, index, &node, &count );
 		}
 
-		count += node->count;
-		node = node->next;
+		/* a run of n already has n here */
+		if ( ! nodeIsRun( node ) )
+		{
+			i = index - count - 1;
 
-		PARANOID_ERR_IF( node == la->tail );
-	}
+			rc = nodeWiden( program, la, &node, intWidth( n ) );
+			ERR_IF_PASSTHROUGH;
 
-	/* *** */
-	if ( node->n != NULL )
+			/* replace int into node */
+			nodeSetInt( node, i, n );
+		}
+	}
+	else if ( canMix( node ) )
 	{
-		i = index - count - 1;
-
-		/* replace int into node */
-		node->n[ i ] = n;
+		rc = mixedReplace( program, la, node, index - count - 1, n, NULL );
+		ERR_IF_PASSTHROUGH;
 	}
 	else /* node is list kind */
 	{
@@ -1435,19 +1943,26 @@ TROT_RC trotListReplaceWithInt( TrotProgram *program, TrotList *l, TROT_INT inde
 		{
 			/* If the previous node is an int node with space, we
 			   can just append in that node. */
-			if (    node->prev->n != NULL
-			     && node->prev->count != TROT_NODE_SIZE 
+			prevNode = trotListNodePrev( la, node );
+
+			if (    prevNode->kind == NODE_KIND_INT
+			     && prevNode->count != prevNode->capacity
 			   )
 			{
+				intNode = prevNode;
+
+				rc = nodeWiden( program, la, &intNode, intWidth( n ) );
+				ERR_IF_PASSTHROUGH;
+
 				/* append int into prev node */
-				node->prev->n[ node->prev->count ] = n;
+				nodeSetInt( intNode, intNode->count, n );
 
-				node->prev->count += 1;
+				nodeAddCount( la, intNode, 1 );
 			}
 			else
 			{
 				/* *** */
-				rc = newIntNode( program, node, n );
+				rc = newIntNode( program, la, node, n );
 				ERR_IF_PASSTHROUGH;
 			}
 		}
@@ -1456,59 +1971,58 @@ TROT_RC trotListReplaceWithInt( TrotProgram *program, TrotList *l, TROT_INT inde
 		{
 			/* if the next node is an int node with room, we can just prepend to
 			   that node. */
-			if (    node->next->n != NULL
-			     && node->next->count != TROT_NODE_SIZE 
+			if (    node->next->kind == NODE_KIND_INT
+			     && node->next->count != node->next->capacity
 			   )
 			{
-				/* prepend int */
-				j = node->next->count;
-				while ( j != 0 )
-				{
-					node->next->n[ j ] = node->next->n[ j - 1 ];
-					j -= 1;
-				}
+				intNode = node->next;
+
+				rc = nodeWiden( program, la, &intNode, intWidth( n ) );
+				ERR_IF_PASSTHROUGH;
 
-				node->next->n[ 0 ] = n;
+				/* prepend int */
+				copyInts( intNode, 1, intNode, 0, intNode->count );
+				nodeSetInt( intNode, 0, n );
 
-				node->next->count += 1;
+				nodeAddCount( la, intNode, 1 );
 			}
 			else
 			{
 				/* *** */
-				rc = newIntNode( program, node->next, n );
+				rc = newIntNode( program, la, node->next, n );
 				ERR_IF_PASSTHROUGH;
 			}
 		}
 		/* we'll have to split the node */
 		else
 		{
-			rc = trotListNodeSplit( program, node, i + 1 );
+			rc = trotListNodeSplit( program, la, node, i + 1 );
 			ERR_IF_PASSTHROUGH;
 
 			/* *** */
-			rc = newIntNode( program, node->next, n );
+			rc = newIntNode( program, la, node->next, n );
 			ERR_IF_PASSTHROUGH;
 		}
 
 		/* we've put in our int, now we need to remove a list */
-		tempL = node->l[ i ];
-		tempL->laParent = NULL;
+		tempL = NODE_LISTS( node )[ i ];
+		refSetParent( tempL, NULL );
 		trotListFree( program, &tempL );
 		while ( i < ( (node->count) - 1 ) )
 		{
-			node->l[ i ] = node->l[ i + 1 ];
+			NODE_LISTS( node )[ i ] = NODE_LISTS( node )[ i + 1 ];
 			i += 1;
 		}
-		node->l[ i ] = NULL;
+		NODE_LISTS( node )[ i ] = NULL;
 
-		node->count -= 1;
+		nodeAddCount( la, node, -1 );
 		if ( node->count == 0 )
 		{
-			node->prev->next = node->next;
-			node->next->prev = node->prev;
-
-			TROT_FREE( node->l, TROT_NODE_SIZE );
-			TROT_FREE( node, 1 );
+			removeNode( program, la, node );
+		}
+		else
+		{
+			nodeMerge( program, la, node );
 		}
 	}
 
@@ -1536,6 +2050,7 @@ TROT_RC trotListReplaceWithList( TrotProgram *program, TrotList *l, TROT_INT ind
 	TrotListActual *la = NULL;
 
 	TrotListNode *node = NULL;
+	TrotListNode *prevNode = NULL;
 
 	TROT_INT count = 0;
 
@@ -1568,22 +2083,10 @@ TROT_RC trotListReplaceWithList( TrotProgram *program, TrotList *l, TROT_INT ind
 	ERR_IF_1( index > (la->childrenCount), TROT_RC_ERROR_BAD_INDEX, index );
 
 	/* Find node where list needs to be replaced into */
-	node = la->head->next;
-	while ( 1 )
-	{
-		if ( count + (node->count) >= index )
-		{
-			break;
-		}
-
-		count += node->count;
-		node = node->next;
-
-		PARANOID_ERR_IF( node == la->tail );
-	}
+	trotListFindNode( la, index, &node, &count );
 
 	/* *** */
-	if ( node->l != NULL )
+	if ( node->kind == NODE_KIND_LIST )
 	{
 		/* create our new twin */
 		rc = trotListTwin( program, lToInsert, &newL );
@@ -1592,15 +2095,20 @@ TROT_RC trotListReplaceWithList( TrotProgram *program, TrotList *l, TROT_INT ind
 		i = index - count - 1;
 
 		/* free old */
-		tempL = node->l[ i ];
-		tempL->laParent = NULL;
+		tempL = NODE_LISTS( node )[ i ];
+		refSetParent( tempL, NULL );
 		trotListFree( program, &tempL );
 
 		/* replace with new */
-		node->l[ i ] = newL;
-		newL->laParent = la;
+		NODE_LISTS( node )[ i ] = newL;
+		refSetParent( newL, la );
 		newL = NULL;
 	}
+	else if ( canMix( node ) )
+	{
+		rc = mixedReplace( program, la, node, index - count - 1, 0, lToInsert );
+		ERR_IF_PASSTHROUGH;
+	}
 	else /* node is int kind */
 	{
 		i = index - count - 1;
@@ -1610,8 +2118,10 @@ TROT_RC trotListReplaceWithList( TrotProgram *program, TrotList *l, TROT_INT ind
 		{
 			/* If the previous node is a list node with space, we
 			   can just append in that node. */
-			if (    node->prev->l != NULL
-			     && node->prev->count != TROT_NODE_SIZE 
+			prevNode = trotListNodePrev( la, node );
+
+			if (    prevNode->kind == NODE_KIND_LIST
+			     && prevNode->count != prevNode->capacity
 			   )
 			{
 				/* create our new twin */
@@ -1619,11 +2129,11 @@ TROT_RC trotListReplaceWithList( TrotProgram *program, TrotList *l, TROT_INT ind
 				ERR_IF_PASSTHROUGH;
 
 				/* append into prev node */
-				node->prev->l[ node->prev->count ] = newL;
-				newL->laParent = la;
+				NODE_LISTS( prevNode )[ prevNode->count ] = newL;
+				refSetParent( newL, la );
 				newL = NULL;
 
-				node->prev->count += 1;
+				nodeAddCount( la, prevNode, 1 );
 			}
 			else
 			{
@@ -1637,8 +2147,8 @@ TROT_RC trotListReplaceWithList( TrotProgram *program, TrotList *l, TROT_INT ind
 		{
 			/* if the next node is a list node with room, we can just prepend to
 			   that node. */
-			if (    node->next->l != NULL
-			     && node->next->count != TROT_NODE_SIZE 
+			if (    node->next->kind == NODE_KIND_LIST
+			     && node->next->count != node->next->capacity
 			   )
 			{
 				/* create our new twin */
@@ -1649,15 +2159,15 @@ TROT_RC trotListReplaceWithList( TrotProgram *program, TrotList *l, TROT_INT ind
 				j = node->next->count;
 				while ( j != 0 )
 				{
-					node->next->l[ j ] = node->next->l[ j - 1 ];
+					NODE_LISTS( node->next )[ j ] = NODE_LISTS( node->next )[ j - 1 ];
 					j -= 1;
 				}
 
-				node->next->l[ 0 ] = newL;
-				newL->laParent = la;
+				NODE_LISTS( node->next )[ 0 ] = newL;
+				refSetParent( newL, la );
 				newL = NULL;
 
-				node->next->count += 1;
+				nodeAddCount( la, node->next, 1 );
 			}
 			else
 			{
@@ -1669,7 +2179,7 @@ TROT_RC trotListReplaceWithList( TrotProgram *program, TrotList *l, TROT_INT ind
 		/* we'll have to split the node */
 		else
 		{
-			rc = trotListNodeSplit( program, node, i + 1 );
+			rc = trotListNodeSplit( program, la, node, i + 1 );
 			ERR_IF_PASSTHROUGH;
 
 			/* *** */
@@ -1678,20 +2188,16 @@ TROT_RC trotListReplaceWithList( TrotProgram *program, TrotList *l, TROT_INT ind
 		}
 
 		/* we've put in our list, now we need to remove an int */
-		while ( i < ( (node->count) - 1 ) )
-		{
-			node->n[ i ] = node->n[ i + 1 ];
-			i += 1;
-		}
+		copyInts( node, i, node, i + 1, (node->count) - i - 1 );
 
-		node->count -= 1;
+		nodeAddCount( la, node, -1 );
 		if ( node->count == 0 )
 		{
-			node->prev->next = node->next;
-			node->next->prev = node->prev;
-
-			TROT_FREE( node->n, TROT_NODE_SIZE );
-			TROT_FREE( node, 1 );
+			removeNode( program, la, node );
+		}
+		else
+		{
+			nodeMerge( program, la, node );
 		}
 	}
 
@@ -1704,362 +2210,4661 @@ TROT_RC trotListReplaceWithList( TrotProgram *program, TrotList *l, TROT_INT ind
 
 /******************************************************************************/
 /*!
-	\brief Gets type of list.
+	\brief Appends an array of ints to the end of the list.
 	\param[in] program List that maintains memory limit
-	\param[in] l The list.
-	\param[out] type The type of the list.
+	\param[in] l The list to append to.
+	\param[in] src The ints to append.
+	\param[in] count How many ints are in src.
 	\return TROT_RC
+
+	Fills whole nodes at a time, so this is much faster than calling
+	trotListAppendInt for each int.
 */
-TROT_RC trotListGetType( TrotProgram *program, TrotList *l, TROT_INT *type )
+TROT_RC trotListAppendInts( TrotProgram *program, TrotList *l, const TROT_INT *src, TROT_INT count )
 {
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+
+
 	/* PRECOND */
 	FAILURE_POINT;
 	PARANOID_ERR_IF( program == NULL );
 	PARANOID_ERR_IF( l == NULL );
-	PARANOID_ERR_IF( type == NULL );
+	PARANOID_ERR_IF( src == NULL && count != 0 );
+	PARANOID_ERR_IF( count < 0 );
 
 
 	/* CODE */
-	(void)program;
+	la = l->laPointsTo;
 
-	(*type) = l->laPointsTo->type;
+	/* lists cannot hold more than TROT_MAX_CHILDREN, so make sure we have room */
+	ERR_IF( TROT_MAX_CHILDREN - la->childrenCount < count, TROT_RC_ERROR_LIST_OVERFLOW );
 
-	return TROT_RC_SUCCESS;
+	/* *** */
+	rc = insertIntsAfter( program, la, la->last, src, count );
+	ERR_IF_PASSTHROUGH;
+
+	la->childrenCount += count;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
 }
 
 /******************************************************************************/
 /*!
-	\brief Sets type of list.
+	\brief Appends copies of an int to the end of the list.
 	\param[in] program List that maintains memory limit
-	\param[in] l The list.
-	\param[in] tag Type value to set.
+	\param[in] l The list to append to.
+	\param[in] n The int to append.
+	\param[in] count How many copies of n to append.
 	\return TROT_RC
+
+	The copies are kept as a run, which takes the same memory however many
+	copies there are. Changing one of them later splits the run.
 */
-TROT_RC trotListSetType( TrotProgram *program, TrotList *l, TROT_INT type )
+TROT_RC trotListAppendRun( TrotProgram *program, TrotList *l, TROT_INT n, TROT_INT count )
 {
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+	TrotListNode *node = NULL;
+	TrotListNode *newNode = NULL;
+
+
 	/* PRECOND */
 	FAILURE_POINT;
 	PARANOID_ERR_IF( program == NULL );
 	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( count < 0 );
 
 
 	/* CODE */
-	(void)program;
+	la = l->laPointsTo;
 
-	l->laPointsTo->type = type;
+	/* lists cannot hold more than TROT_MAX_CHILDREN, so make sure we have room */
+	ERR_IF( TROT_MAX_CHILDREN - la->childrenCount < count, TROT_RC_ERROR_LIST_OVERFLOW );
 
-	return TROT_RC_SUCCESS;
+	if ( count == 0 )
+	{
+		return TROT_RC_SUCCESS;
+	}
+
+	/* *** */
+	node = la->last;
+
+	/* if last node is a run of n, it just gets longer */
+	if ( nodeIsRun( node ) && NODE_GET_INT( node, 0 ) == n )
+	{
+		nodeAddCount( la, node, count );
+	}
+	else
+	{
+		rc = nodeAllocRun( program, n, &newNode );
+		ERR_IF_PASSTHROUGH;
+
+		rc = linkNode( program, la, node, newNode );
+		ERR_IF_PASSTHROUGH;
+
+		nodeAddCount( la, newNode, count );
+		newNode = NULL;
+	}
+
+	la->childrenCount += count;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	nodeFree( program, la, newNode );
+
+	return rc;
 }
 
 /******************************************************************************/
 /*!
-	\brief Gets tag of list.
+	\brief Inserts an array of ints into the list.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list to insert into.
+	\param[in] index Where to insert. The first int in src will end up at
+		index.
+	\param[in] src The ints to insert.
+	\param[in] count How many ints are in src.
+	\return TROT_RC
+*/
+TROT_RC trotListInsertInts( TrotProgram *program, TrotList *l, TROT_INT index, const TROT_INT *src, TROT_INT count )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+
+	TrotListNode *node = NULL;
+
+	TROT_INT countBefore = 0;
+
+	TROT_INT i = 0;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( src == NULL && count != 0 );
+	PARANOID_ERR_IF( count < 0 );
+
+
+	/* CODE */
+	la = l->laPointsTo;
+
+	/* lists cannot hold more than TROT_MAX_CHILDREN, so make sure we have room */
+	ERR_IF( TROT_MAX_CHILDREN - la->childrenCount < count, TROT_RC_ERROR_LIST_OVERFLOW );
+
+	/* Turn negative index into positive equivalent. */
+	if ( index < 0 )
+	{
+		index = (la->childrenCount) + index + 2;
+	}
+
+	/* If they want to add to the end of the list, or to an empty list. */
+	if ( index == (la->childrenCount) + 1 )
+	{
+		rc = trotListAppendInts( program, l, src, count );
+		ERR_IF_PASSTHROUGH;
+
+		return TROT_RC_SUCCESS;
+	}
+
+	/* Make sure index is in range */
+	ERR_IF_1( index <= 0, TROT_RC_ERROR_BAD_INDEX, index );
+	ERR_IF_1( index > (la->childrenCount), TROT_RC_ERROR_BAD_INDEX, index );
+
+	if ( count == 0 )
+	{
+		return TROT_RC_SUCCESS;
+	}
+
+	/* Find node where ints need to be inserted */
+	trotListFindNode( la, index, &node, &countBefore );
+
+	/* if not at beginning of node, we'll have to split it so we can insert
+	   after the left half */
+	i = index - countBefore - 1;
+	if ( i != 0 )
+	{
+		rc = trotListNodeSplit( program, la, node, i );
+		ERR_IF_PASSTHROUGH;
+	}
+	else
+	{
+		node = trotListNodePrev( la, node );
+	}
+
+	/* *** */
+	rc = insertIntsAfter( program, la, node, src, count );
+	ERR_IF_PASSTHROUGH;
+
+	la->childrenCount += count;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Copies a run of ints out of the list.
 	\param[in] program List that maintains memory limit
 	\param[in] l The list.
-	\param[out] tag The tag of the list.
+	\param[in] start Index of the first int to get.
+	\param[in] count How many ints to get.
+	\param[out] dst On success, will hold the count ints starting at start.
+		Must have room for count ints.
 	\return TROT_RC
+
+	If any item in the run is a list, TROT_RC_ERROR_WRONG_KIND is returned,
+	and dst may have been partially written.
 */
-TROT_RC trotListGetTag( TrotProgram *program, TrotList *l, TROT_INT *tag )
+TROT_RC trotListGetInts( TrotProgram *program, TrotList *l, TROT_INT start, TROT_INT count, TROT_INT *dst )
 {
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+
+	TrotListNode *node = NULL;
+
+	TROT_INT countBefore = 0;
+
+	TROT_INT i = 0;
+	TROT_INT j = 0;
+	TROT_INT copied = 0;
+	TROT_INT toCopy = 0;
+
+
 	/* PRECOND */
 	FAILURE_POINT;
 	PARANOID_ERR_IF( program == NULL );
 	PARANOID_ERR_IF( l == NULL );
-	PARANOID_ERR_IF( tag == NULL );
+	PARANOID_ERR_IF( dst == NULL && count != 0 );
+	PARANOID_ERR_IF( count < 0 );
 
 
 	/* CODE */
 	(void)program;
 
-	(*tag) = l->laPointsTo->tag;
+	la = l->laPointsTo;
+
+	/* Turn negative index into positive equivalent. */
+	if ( start < 0 )
+	{
+		start = (la->childrenCount) + start + 1;
+	}
+
+	/* Make sure the whole run is in range */
+	ERR_IF_1( start <= 0, TROT_RC_ERROR_BAD_INDEX, start );
+	ERR_IF_2( start - 1 > (la->childrenCount) - count, TROT_RC_ERROR_BAD_INDEX, start, count );
+
+	if ( count == 0 )
+	{
+		return TROT_RC_SUCCESS;
+	}
+
+	/* *** */
+	trotListFindNode( la, start, &node, &countBefore );
+
+	i = start - countBefore - 1;
+	while ( copied < count )
+	{
+		ERR_IF( node->kind == NODE_KIND_LIST, TROT_RC_ERROR_WRONG_KIND );
+
+		toCopy = (node->count) - i;
+		if ( toCopy > count - copied )
+		{
+			toCopy = count - copied;
+		}
+
+		if ( node->kind == NODE_KIND_INT && node->width == NODE_WIDTH_FULL )
+		{
+			memcpy( &( dst[ copied ] ), NODE_INT_AT( node, i ), sizeof( TROT_INT ) * toCopy );
+		}
+		else if ( node->kind == NODE_KIND_INT )
+		{
+			for ( j = 0; j < toCopy; j += 1 )
+			{
+				dst[ copied + j ] = NODE_GET_INT( node, i + j );
+			}
+		}
+		else
+		{
+			for ( j = 0; j < toCopy; j += 1 )
+			{
+				ERR_IF( NODE_SLOTS( node )[ i + j ].kind != NODE_KIND_INT, TROT_RC_ERROR_WRONG_KIND );
+
+				dst[ copied + j ] = NODE_SLOTS( node )[ i + j ].u.n;
+			}
+		}
+		copied += toCopy;
+
+		i = 0;
+		node = node->next;
+	}
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Removes a run of items from the list.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list.
+	\param[in] start Index of the first item to remove.
+	\param[in] end Index of the last item to remove.
+	\return TROT_RC
+
+	Finds the run once, frees the nodes that are wholly inside it, and only
+	shifts the items in the nodes at either end.
+*/
+TROT_RC trotListRemoveRange( TrotProgram *program, TrotList *l, TROT_INT start, TROT_INT end )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+
+	TrotListNode *node = NULL;
+
+	TROT_INT count = 0;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+
+
+	/* CODE */
+	la = l->laPointsTo;
+
+	/* Turn negative indices into positive equivalents. */
+	if ( start < 0 )
+	{
+		start = (la->childrenCount) + start + 1;
+	}
+	if ( end < 0 )
+	{
+		end = (la->childrenCount) + end + 1;
+	}
+
+	/* Make sure range is in range */
+	ERR_IF_1( start <= 0, TROT_RC_ERROR_BAD_INDEX, start );
+	ERR_IF_2( end < start, TROT_RC_ERROR_BAD_INDEX, start, end );
+	ERR_IF_1( end > (la->childrenCount), TROT_RC_ERROR_BAD_INDEX, end );
+
+	/* *** */
+	trotListFindNode( la, start, &node, &count );
+
+	removeItems( program, la, node, start - count - 1, end - start + 1 );
 
 	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Replaces a run of items in the list with the items of another list.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list.
+	\param[in] start Index of the first item to replace.
+	\param[in] end Index of the last item to replace.
+	\param[in] lReplacement List whose items will be copied in. Lists in it
+		are twinned. Can be l.
+	\return TROT_RC
+
+	The new items are copied in before the run is removed, so on failure l is
+	left the way it was.
+*/
+TROT_RC trotListReplaceRange( TrotProgram *program, TrotList *l, TROT_INT start, TROT_INT end, TrotList *lReplacement )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+
+	TrotList *lTemp = NULL;
+	TrotListActual *laFrom = NULL;
+
+	TrotListNode *node = NULL;
+
+	TROT_INT count = 0;
+
+	TROT_INT i = 0;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( lReplacement == NULL );
+
+
+	/* CODE */
+	la = l->laPointsTo;
+
+	/* Turn negative indices into positive equivalents. */
+	if ( start < 0 )
+	{
+		start = (la->childrenCount) + start + 1;
+	}
+	if ( end < 0 )
+	{
+		end = (la->childrenCount) + end + 1;
+	}
+
+	/* Make sure range is in range */
+	ERR_IF_1( start <= 0, TROT_RC_ERROR_BAD_INDEX, start );
+	ERR_IF_2( end < start, TROT_RC_ERROR_BAD_INDEX, start, end );
+	ERR_IF_1( end > (la->childrenCount), TROT_RC_ERROR_BAD_INDEX, end );
+
+	/* if we're replacing with ourself, copy ourself first, so we're not
+	   reading from the list we're inserting into */
+	laFrom = lReplacement->laPointsTo;
+	if ( laFrom == la )
+	{
+		rc = trotListSlice( program, l, 1, -1, &lTemp );
+		ERR_IF_PASSTHROUGH;
+
+		laFrom = lTemp->laPointsTo;
+	}
+
+	/* lists cannot hold more than TROT_MAX_CHILDREN, so make sure we have room */
+	ERR_IF( TROT_MAX_CHILDREN - ( (la->childrenCount) - ( end - start + 1 ) ) < laFrom->childrenCount, TROT_RC_ERROR_LIST_OVERFLOW );
+
+	/* copy new items in before start */
+	if ( laFrom->childrenCount > 0 )
+	{
+		trotListFindNode( la, start, &node, &count );
+
+		/* if not at beginning of node, we'll have to split it so we can
+		   insert after the left half */
+		i = start - count - 1;
+		if ( i != 0 )
+		{
+			rc = trotListNodeSplit( program, la, node, i );
+			ERR_IF_PASSTHROUGH;
+		}
+		else
+		{
+			node = trotListNodePrev( la, node );
+		}
+
+		rc = copyItemsAfter( program, la, node, laFrom->headNode.next, 0, laFrom->childrenCount );
+		ERR_IF_PASSTHROUGH;
+
+		la->childrenCount += laFrom->childrenCount;
+	}
+
+	/* and remove the old ones */
+	start += laFrom->childrenCount;
+	trotListFindNode( la, start, &node, &count );
+
+	removeItems( program, la, node, start - count - 1, end - start + 1 + laFrom->childrenCount );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &lTemp );
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Creates a new list holding a copy of a run of items in the list.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list.
+	\param[in] start Index of the first item to copy.
+	\param[in] end Index of the last item to copy.
+	\param[out] lSlice_A On success, new list with the items. Lists are
+		twinned, not copied.
+	\return TROT_RC
+*/
+TROT_RC trotListSlice( TrotProgram *program, TrotList *l, TROT_INT start, TROT_INT end, TrotList **lSlice_A )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+
+	TrotList *newL = NULL;
+
+	TrotListNode *node = NULL;
+
+	TROT_INT count = 0;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( lSlice_A == NULL );
+	PARANOID_ERR_IF( (*lSlice_A) != NULL );
+
+
+	/* CODE */
+	la = l->laPointsTo;
+
+	/* Turn negative indices into positive equivalents. */
+	if ( start < 0 )
+	{
+		start = (la->childrenCount) + start + 1;
+	}
+	if ( end < 0 )
+	{
+		end = (la->childrenCount) + end + 1;
+	}
+
+	/* Make sure range is in range */
+	ERR_IF_1( start <= 0, TROT_RC_ERROR_BAD_INDEX, start );
+	ERR_IF_2( end < start, TROT_RC_ERROR_BAD_INDEX, start, end );
+	ERR_IF_1( end > (la->childrenCount), TROT_RC_ERROR_BAD_INDEX, end );
+
+	/* *** */
+	rc = trotListInit( program, &newL );
+	ERR_IF_PASSTHROUGH;
+
+	trotListFindNode( la, start, &node, &count );
+
+	rc = copyItemsAfter( program, newL->laPointsTo, &( newL->laPointsTo->headNode ), node, start - count - 1, end - start + 1 );
+	ERR_IF_PASSTHROUGH;
+
+	newL->laPointsTo->childrenCount = end - start + 1;
+
+	/* give back */
+	(*lSlice_A) = newL;
+	newL = NULL;
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &newL );
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Moves all the items of one list onto the end of another.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list to move the items onto.
+	\param[in] lFrom The list to move the items from. Will be empty after.
+		Must not be the same list as l.
+	\return TROT_RC
+
+	The nodes of lFrom are relinked onto the end of l, and lFrom's index is
+	grafted onto l's, so no items are copied. Only lists in lFrom have to be
+	touched, to point them at their new parent.
+*/
+TROT_RC trotListConcat( TrotProgram *program, TrotList *l, TrotList *lFrom )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+	TrotListActual *laFrom = NULL;
+
+	TrotListNode *node = NULL;
+
+	TrotListNode *first = NULL;
+	TrotListNode *last = NULL;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( lFrom == NULL );
+
+
+	/* CODE */
+	la = l->laPointsTo;
+	laFrom = lFrom->laPointsTo;
+
+	/* can't move a list onto itself */
+	ERR_IF( la == laFrom, TROT_RC_ERROR_PRECOND );
+
+	/* lists cannot hold more than TROT_MAX_CHILDREN, so make sure we have room */
+	ERR_IF( TROT_MAX_CHILDREN - la->childrenCount < laFrom->childrenCount, TROT_RC_ERROR_LIST_OVERFLOW );
+
+	if ( laFrom->childrenCount == 0 )
+	{
+		return TROT_RC_SUCCESS;
+	}
+
+	/* lFrom's inline node can only move into l's inline node, so if l's is
+	   in use, lFrom's has to be a normal node first */
+	if ( inlineNodeUsed( laFrom ) && inlineNodeUsed( la ) )
+	{
+		node = &( laFrom->inlineNode );
+		rc = nodeRealloc( program, laFrom, &node );
+		ERR_IF_PASSTHROUGH;
+	}
+
+	/* join the indexes, since that's the last thing that can fail */
+	rc = indexJoin( program, la, laFrom );
+	ERR_IF_PASSTHROUGH;
+
+	/* move the nodes */
+	first = laFrom->headNode.next;
+	last = laFrom->last;
+
+	la->last->next = first;
+	last->next = &( la->headNode );
+	la->last = last;
+
+	laFrom->headNode.next = &( laFrom->headNode );
+	laFrom->last = &( laFrom->headNode );
+
+	reparentNodes( program, laFrom, la, first, &( la->headNode ) );
+
+	/* *** */
+	la->childrenCount += laFrom->childrenCount;
+
+	laFrom->childrenCount = 0;
+	laFrom->fingerNode = NULL;
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Moves the items after index into a new list.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list to split.
+	\param[in] index How many items to keep in l. Can be 0, to move all of
+		them.
+	\param[out] lRest_A On success, new list with the items that were after
+		index.
+	\return TROT_RC
+
+	The nodes after index are relinked into the new list, and l's index is
+	split along the path to index, so no items are copied. Only lists that
+	move have to be touched, to point them at their new parent.
+*/
+TROT_RC trotListSplitAt( TrotProgram *program, TrotList *l, TROT_INT index, TrotList **lRest_A )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+
+	TrotList *newL = NULL;
+	TrotListActual *newLa = NULL;
+
+	TrotListNode *node = NULL;
+
+	TROT_INT count = 0;
+
+	TrotListNode *first = NULL;
+	TrotListNode *last = NULL;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( lRest_A == NULL );
+	PARANOID_ERR_IF( (*lRest_A) != NULL );
+
+
+	/* CODE */
+	la = l->laPointsTo;
+
+	/* Turn negative index into positive equivalent. */
+	if ( index < 0 )
+	{
+		index = (la->childrenCount) + index + 1;
+	}
+
+	/* Make sure index is in range */
+	ERR_IF_1( index < 0, TROT_RC_ERROR_BAD_INDEX, index );
+	ERR_IF_1( index > (la->childrenCount), TROT_RC_ERROR_BAD_INDEX, index );
+
+	/* *** */
+	rc = trotListInit( program, &newL );
+	ERR_IF_PASSTHROUGH;
+
+	newLa = newL->laPointsTo;
+
+	if ( index < la->childrenCount )
+	{
+		if ( index == 0 )
+		{
+			/* everything moves, so the whole index moves too */
+			newLa->indexRoot = la->indexRoot;
+			la->indexRoot = NULL;
+			la->fingerNode = NULL;
+
+			node = &( la->headNode );
+		}
+		else
+		{
+			trotListFindNode( la, index, &node, &count );
+
+			/* split node so index is the last item in it */
+			if ( index - count < node->count )
+			{
+				rc = trotListNodeSplit( program, la, node, index - count );
+				ERR_IF_PASSTHROUGH;
+			}
+
+			rc = indexSplit( program, la, newLa, node );
+			ERR_IF_PASSTHROUGH;
+
+			/* drop the finger if it moved */
+			if ( la->fingerNode != NULL && la->fingerStart >= index )
+			{
+				la->fingerNode = NULL;
+			}
+		}
+
+		/* move the nodes after node */
+		first = node->next;
+		last = la->last;
+
+		node->next = &( la->headNode );
+		la->last = node;
+
+		newLa->headNode.next = first;
+		last->next = &( newLa->headNode );
+		newLa->last = last;
+
+		reparentNodes( program, la, newLa, first, &( newLa->headNode ) );
+
+		/* *** */
+		newLa->childrenCount = (la->childrenCount) - index;
+		la->childrenCount = index;
+	}
+
+	/* give back */
+	(*lRest_A) = newL;
+	newL = NULL;
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &newL );
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Packs the items of the list into as few nodes as possible.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list.
+	\return TROT_RC
+
+	Each run of nodes of the same kind, int, list, or mixed, ends up in full
+	nodes, except for the last node of the run. Nodes that end up empty are freed, and the memory they
+	used is given back to program. Nodes that are bigger than they need to be,
+	for their items and for how big the list is now, are shrunk.
+*/
+TROT_RC trotListCompact( TrotProgram *program, TrotList *l )
+{
+	/* DATA */
+	TrotListActual *la = NULL;
+
+	TrotListNode *node = NULL;
+
+	TROT_INT count = 0;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+
+
+	/* CODE */
+	la = l->laPointsTo;
+
+	node = la->headNode.next;
+	while ( node != &( la->headNode ) )
+	{
+		/* fill node from the nodes after it */
+		while (    node->count < node->capacity
+		        && node->next != &( la->headNode )
+		        && sameKind( node, node->next )
+		      )
+		{
+			/* an int node has to be as wide as the ints it takes. this only
+			   saves memory, so if it fails the node is just left the way it
+			   is. */
+			if (    ! canMove( node, node->next )
+			     && nodeWiden( program, la, &node, nodeIntsWidth( node->next ) ) != TROT_RC_SUCCESS
+			   )
+			{
+				break;
+			}
+
+			count = (node->capacity) - (node->count);
+			if ( count > node->next->count )
+			{
+				count = node->next->count;
+			}
+
+			moveItems( program, la, node, node->next, count );
+		}
+
+		/* runs of the same int next to each other become one run */
+		while (    nodeIsRun( node )
+		        && nodeIsRun( node->next )
+		        && NODE_GET_INT( node, 0 ) == NODE_GET_INT( node->next, 0 )
+		      )
+		{
+			count = node->next->count;
+			nodeAddCount( la, node->next, -count );
+			nodeAddCount( la, node, count );
+			removeNode( program, la, node->next );
+		}
+
+		/* give back room the node doesn't need. this only saves memory, so
+		   if it fails the node is just left the way it is. */
+		if (    node != &( la->inlineNode )
+		     && ! nodeIsRun( node )
+		     && node->capacity > nodeCapacity( la->childrenCount, node->count )
+		   )
+		{
+			(void)nodeRealloc( program, la, &node );
+		}
+
+		node = node->next;
+	}
+
+	return TROT_RC_SUCCESS;
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets type of list.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list.
+	\param[out] type The type of the list.
+	\return TROT_RC
+*/
+TROT_RC trotListGetType( TrotProgram *program, TrotList *l, TROT_INT *type )
+{
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( type == NULL );
+
+
+	/* CODE */
+	(void)program;
+
+	(*type) = l->laPointsTo->type;
+
+	return TROT_RC_SUCCESS;
+}
+
+/******************************************************************************/
+/*!
+	\brief Sets type of list.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list.
+	\param[in] tag Type value to set.
+	\return TROT_RC
+*/
+TROT_RC trotListSetType( TrotProgram *program, TrotList *l, TROT_INT type )
+{
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+
+
+	/* CODE */
+	(void)program;
+
+	l->laPointsTo->type = type;
+
+	return TROT_RC_SUCCESS;
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets tag of list.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list.
+	\param[out] tag The tag of the list.
+	\return TROT_RC
+*/
+TROT_RC trotListGetTag( TrotProgram *program, TrotList *l, TROT_INT *tag )
+{
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( tag == NULL );
+
+
+	/* CODE */
+	(void)program;
+
+	(*tag) = l->laPointsTo->tag;
+
+	return TROT_RC_SUCCESS;
+}
+
+/******************************************************************************/
+/*!
+	\brief Sets the tag of a list.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list.
+	\param[in] tag The tag value to set.
+	\return TROT_RC
+*/
+TROT_RC trotListSetTag( TrotProgram *program, TrotList *l, TROT_INT tag )
+{
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+
+
+	/* CODE */
+	(void)program;
+
+	l->laPointsTo->tag = tag;
+
+	return TROT_RC_SUCCESS;
+}
+
+/******************************************************************************/
+/*!
+	\brief Splits a node, leaving keepInLeft into the left/prev node, and
+		moving the rest into the new right/next node.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that n is in.
+	\param[in] n Node to split.
+	\param[in] keepInLeft How many items to keep in n.
+	\return TROT_RC
+*/
+static TROT_RC trotListNodeSplit( TrotProgram *program, TrotListActual *la, TrotListNode *n, TROT_INT keepInLeft )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListNode *newNode = NULL;
+
+	TROT_INT moved = 0;
+
+	TROT_INT i = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( n == NULL );
+
+
+	/* CODE */
+	if ( nodeIsRun( n ) )
+	{
+		rc = nodeAllocRun( program, NODE_GET_INT( n, 0 ), &newNode );
+	}
+	else
+	{
+		/* room for one more, since nodeMakeRoom may insert into either half */
+		rc = nodeAlloc( program, la, nodeKind( n ), n->width, (n->count) - keepInLeft + 1, &newNode );
+	}
+	ERR_IF_PASSTHROUGH;
+
+	/* link the empty node in after n. this is the last thing that can fail. */
+	rc = linkNode( program, la, n, newNode );
+	ERR_IF_PASSTHROUGH;
+
+	/* move items */
+	moved = (n->count) - keepInLeft;
+
+	if ( n->kind == NODE_KIND_INT )
+	{
+		copyInts( newNode, 0, n, keepInLeft, moved );
+	}
+	else if ( n->kind == NODE_KIND_LIST )
+	{
+		i = keepInLeft;
+		while ( i < (n->count) )
+		{
+			NODE_LISTS( newNode )[ i - keepInLeft ] = NODE_LISTS( n )[ i ];
+			NODE_LISTS( n )[ i ] = NULL;
+
+			i += 1;
+		}
+	}
+	else /* n is mixed kind */
+	{
+		memcpy( NODE_SLOTS( newNode ), &( NODE_SLOTS( n )[ keepInLeft ] ), sizeof( TrotListSlot ) * moved );
+		memset( &( NODE_SLOTS( n )[ keepInLeft ] ), 0, sizeof( TrotListSlot ) * moved );
+	}
+
+	nodeAddCount( la, n, -moved );
+	nodeAddCount( la, newNode, moved );
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	nodeFree( program, la, newNode );
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Creates a new TrotListNode for Int.
+	\param[in] program List that maintains memory limit
+	\param[in] la List to insert into.
+	\param[in] insertBeforeThis Node in list to insert before, or la's head to append
+	\param[in] n Int to insert into new node.
+	\return TROT_RC
+*/
+static TROT_RC newIntNode( TrotProgram *program, TrotListActual *la, TrotListNode *insertBeforeThis, TROT_INT n )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListNode *newNode = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( insertBeforeThis == NULL );
+
+
+	/* CODE */
+	rc = nodeAlloc( program, la, NODE_KIND_INT, intWidth( n ), 1, &newNode );
+	ERR_IF_PASSTHROUGH;
+
+	newNode->count = 1;
+
+	nodeSetInt( newNode, 0, n );
+
+	/* insert node in list */
+	rc = linkNode( program, la, trotListNodePrev( la, insertBeforeThis ), newNode );
+	ERR_IF_PASSTHROUGH;
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	nodeFree( program, la, newNode );
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Creates a new TrotListNode for List.
+	\param[in] program List that maintains memory limit
+	\param[in] la List to insert into.
+	\param[in] insertBeforeThis Node in list to insert before, or la's head to append
+	\param[in] l List to twin and insert into new node
+	\return TROT_RC
+*/
+static TROT_RC newListNode( TrotProgram *program, TrotListActual *la, TrotListNode *insertBeforeThis, TrotList *l )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListNode *newNode = NULL;
+
+	TrotList *newL = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( insertBeforeThis == NULL );
+	PARANOID_ERR_IF( l == NULL );
+
+
+	/* CODE */
+	rc = trotListTwin( program, l, &newL );
+	ERR_IF_PASSTHROUGH;
+
+	rc = nodeAlloc( program, la, NODE_KIND_LIST, 0, 1, &newNode );
+	ERR_IF_PASSTHROUGH;
+
+	newNode->count = 1;
+
+	/* insert node in list */
+	rc = linkNode( program, la, trotListNodePrev( la, insertBeforeThis ), newNode );
+	ERR_IF_PASSTHROUGH;
+
+	NODE_LISTS( newNode )[ 0 ] = newL;
+	refSetParent( newL, la );
+	newL = NULL;
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &newL );
+	nodeFree( program, la, newNode );
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Inserts an array of ints after prevNode, filling whole nodes at a
+		time.
+	\param[in] program List that maintains memory limit
+	\param[in] la List to insert into.
+	\param[in] prevNode Node to insert after. Can be la's head.
+	\param[in] src The ints to insert.
+	\param[in] count How many ints are in src.
+	\return TROT_RC
+
+	Any room left in prevNode is used first. The memory limit is checked once
+	for all of the new nodes up front. On failure the list is left the way it
+	was. Doesn't change la's childrenCount.
+*/
+static TROT_RC insertIntsAfter( TrotProgram *program, TrotListActual *la, TrotListNode *prevNode, const TROT_INT *src, TROT_INT count )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TROT_INT room = 0;
+	TROT_INT nodesNeeded = 0;
+
+	TrotListNode *newNode = NULL;
+	TrotListNode *lastNode = NULL;
+
+	TROT_INT copied = 0;
+	TROT_INT toCopy = 0;
+
+	TROT_INT j = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( prevNode == NULL );
+	PARANOID_ERR_IF( count < 0 );
+
+
+	/* CODE */
+	lastNode = prevNode;
+
+	/* the inline node moves into a bigger normal node if this won't fit in
+	   it */
+	if (    prevNode == &( la->inlineNode )
+	     && prevNode->kind == NODE_KIND_INT
+	     && (prevNode->count) + count > prevNode->capacity
+	     && prevNode->capacity < TROT_NODE_SIZE
+	   )
+	{
+		rc = nodeRealloc( program, la, &prevNode );
+		ERR_IF_PASSTHROUGH;
+
+		lastNode = prevNode;
+	}
+
+	/* how much room is left in prevNode? */
+	if ( prevNode != &( la->headNode ) && prevNode->kind == NODE_KIND_INT )
+	{
+		room = (prevNode->capacity) - (prevNode->count);
+		if ( room > count )
+		{
+			room = count;
+		}
+	}
+
+	/* check memory limit once for all the nodes we'll need. nodes may be
+	   bigger than TROT_NODE_SIZE, so this is only about right, but each
+	   node still checks the limit when it's allocated. */
+	nodesNeeded = ( count - room + TROT_NODE_SIZE - 1 ) / TROT_NODE_SIZE;
+	ERR_IF(    nodesNeeded > 0
+	        && ( program->memoryLimit - program->memoryUsed ) / (TROT_INT)( sizeof( TrotListNode ) + ( sizeof( TROT_INT ) * TROT_NODE_SIZE ) ) < nodesNeeded,
+	        TROT_RC_ERROR_MEM_LIMIT );
+
+	/* fill prevNode */
+	if ( room > 0 )
+	{
+		rc = nodeWiden( program, la, &prevNode, intsWidth( src, room ) );
+		ERR_IF_PASSTHROUGH;
+
+		lastNode = prevNode;
+
+		for ( copied = 0; copied < room; copied += 1 )
+		{
+			nodeSetInt( prevNode, (prevNode->count) + copied, src[ copied ] );
+		}
+		nodeAddCount( la, prevNode, room );
+	}
+
+	/* create full nodes for the rest */
+	while ( copied < count )
+	{
+		/* nodes get bigger as the list does */
+		toCopy = nodeCapacity( (la->childrenCount) + copied, 0 );
+		if ( toCopy > count - copied )
+		{
+			toCopy = count - copied;
+		}
+
+		rc = nodeAlloc( program, la, NODE_KIND_INT, intsWidth( &( src[ copied ] ), toCopy ), toCopy, &newNode );
+		ERR_IF_PASSTHROUGH;
+
+		PARANOID_ERR_IF( toCopy > newNode->capacity );
+
+		for ( j = 0; j < toCopy; j += 1 )
+		{
+			nodeSetInt( newNode, j, src[ copied + j ] );
+		}
+		newNode->count = toCopy;
+
+		rc = linkNode( program, la, lastNode, newNode );
+		ERR_IF_PASSTHROUGH;
+
+		lastNode = newNode;
+		newNode = NULL;
+
+		copied += toCopy;
+	}
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	nodeFree( program, la, newNode );
+
+	/* take back the nodes we added */
+	lastNode = lastNode->next;
+	while ( prevNode->next != lastNode )
+	{
+		newNode = prevNode->next;
+
+		nodeAddCount( la, newNode, -(newNode->count) );
+		removeNode( program, la, newNode );
+	}
+
+	/* and what we put in prevNode */
+	if ( room > 0 && copied > 0 )
+	{
+		nodeAddCount( la, prevNode, -room );
+	}
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Copies a run of items into new nodes linked after prevNode.
+	\param[in] program List that maintains memory limit
+	\param[in] la List to copy into.
+	\param[in] prevNode Node to insert after. Can be la's head.
+	\param[in] fromNode Node that holds the first item to copy. Must not be
+		in la.
+	\param[in] fromI Where the first item to copy is in fromNode.
+	\param[in] count How many items to copy.
+	\return TROT_RC
+
+	Items are packed into as few nodes as their kinds allow. Lists are
+	twinned, and runs are copied as runs. On failure the list is left the way it was. Doesn't change la's
+	childrenCount.
+*/
+static TROT_RC copyItemsAfter( TrotProgram *program, TrotListActual *la, TrotListNode *prevNode, TrotListNode *fromNode, TROT_INT fromI, TROT_INT count )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListNode *newNode = NULL;
+	TrotListNode *lastNode = NULL;
+
+	TrotList *newL = NULL;
+
+	TROT_INT copied = 0;
+	TROT_INT toCopy = 0;
+
+	TROT_INT j = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( prevNode == NULL );
+	PARANOID_ERR_IF( fromNode == NULL );
+	PARANOID_ERR_IF( count < 0 );
+
+
+	/* CODE */
+	lastNode = prevNode;
+	while ( copied < count )
+	{
+		/* runs are copied as runs */
+		if ( nodeIsRun( fromNode ) )
+		{
+			toCopy = (fromNode->count) - fromI;
+			if ( toCopy > count - copied )
+			{
+				toCopy = count - copied;
+			}
+
+			rc = nodeAllocRun( program, NODE_GET_INT( fromNode, 0 ), &newNode );
+			ERR_IF_PASSTHROUGH;
+
+			rc = linkNode( program, la, lastNode, newNode );
+			ERR_IF_PASSTHROUGH;
+
+			lastNode = newNode;
+			newNode = NULL;
+
+			nodeAddCount( la, lastNode, toCopy );
+		}
+		else
+		{
+			/* do we need a new node? */
+			if (    lastNode == prevNode
+			     || ! sameKind( lastNode, fromNode )
+			     || lastNode->count == lastNode->capacity
+			   )
+			{
+				/* nodes get bigger as the list does */
+				toCopy = nodeCapacity( (la->childrenCount) + copied, 0 );
+				if ( toCopy > count - copied )
+				{
+					toCopy = count - copied;
+				}
+
+				rc = nodeAlloc( program, la, nodeKind( fromNode ), fromNode->width, toCopy, &newNode );
+				ERR_IF_PASSTHROUGH;
+
+				rc = linkNode( program, la, lastNode, newNode );
+				ERR_IF_PASSTHROUGH;
+
+				lastNode = newNode;
+				newNode = NULL;
+			}
+
+			/* how many can we copy from this node into lastNode? */
+			toCopy = (fromNode->count) - fromI;
+			if ( toCopy > count - copied )
+			{
+				toCopy = count - copied;
+			}
+			if ( toCopy > (lastNode->capacity) - (lastNode->count) )
+			{
+				toCopy = (lastNode->capacity) - (lastNode->count);
+			}
+
+			/* copy */
+			if ( fromNode->kind == NODE_KIND_INT )
+			{
+				rc = nodeWiden( program, la, &lastNode, nodeIntsWidth( fromNode ) );
+				ERR_IF_PASSTHROUGH;
+
+				copyInts( lastNode, lastNode->count, fromNode, fromI, toCopy );
+				nodeAddCount( la, lastNode, toCopy );
+			}
+			else if ( fromNode->kind == NODE_KIND_LIST )
+			{
+				for ( j = 0; j < toCopy; j += 1 )
+				{
+					rc = trotListTwin( program, NODE_LISTS( fromNode )[ fromI + j ], &newL );
+					ERR_IF_PASSTHROUGH;
+
+					NODE_LISTS( lastNode )[ lastNode->count ] = newL;
+					refSetParent( newL, la );
+					newL = NULL;
+
+					nodeAddCount( la, lastNode, 1 );
+				}
+			}
+			else
+			{
+				for ( j = 0; j < toCopy; j += 1 )
+				{
+					if ( NODE_SLOTS( fromNode )[ fromI + j ].kind == NODE_KIND_LIST )
+					{
+						rc = trotListTwin( program, NODE_SLOTS( fromNode )[ fromI + j ].u.l, &newL );
+						ERR_IF_PASSTHROUGH;
+
+						NODE_SLOTS( lastNode )[ lastNode->count ].kind = NODE_KIND_LIST;
+						NODE_SLOTS( lastNode )[ lastNode->count ].u.l = newL;
+						refSetParent( newL, la );
+						newL = NULL;
+					}
+					else
+					{
+						NODE_SLOTS( lastNode )[ lastNode->count ] = NODE_SLOTS( fromNode )[ fromI + j ];
+					}
+
+					nodeAddCount( la, lastNode, 1 );
+				}
+			}
+		}
+
+		copied += toCopy;
+
+		/* next */
+		fromI += toCopy;
+		if ( fromI == fromNode->count )
+		{
+			fromNode = fromNode->next;
+			fromI = 0;
+		}
+	}
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	nodeFree( program, la, newNode );
+
+	/* take back the nodes we added */
+	lastNode = lastNode->next;
+	while ( prevNode->next != lastNode )
+	{
+		newNode = prevNode->next;
+
+		if ( newNode->kind == NODE_KIND_LIST )
+		{
+			freeRefs( program, NODE_LISTS( newNode ), newNode->count );
+		}
+		else if ( newNode->kind == NODE_KIND_MIXED )
+		{
+			freeSlots( program, NODE_SLOTS( newNode ), newNode->count );
+		}
+
+		nodeAddCount( la, newNode, -(newNode->count) );
+		removeNode( program, la, newNode );
+	}
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Removes a run of items, starting in node.
+	\param[in] program List that maintains memory limit
+	\param[in] la List to remove from.
+	\param[in] node Node that holds the first item to remove.
+	\param[in] i Where the first item to remove is in node.
+	\param[in] count How many items to remove. Must all be in la.
+	\return void
+
+	Nodes that are wholly inside the run are freed without shifting anything.
+	Only the nodes at either end of the run have items shifted, and then
+	they're merged with their neighbours if they're too empty.
+*/
+static void removeItems( TrotProgram *program, TrotListActual *la, TrotListNode *node, TROT_INT i, TROT_INT count )
+{
+	/* DATA */
+	TrotListNode *before = NULL;
+	TrotListNode *nextNode = NULL;
+
+	TROT_INT toRemove = 0;
+	TROT_INT left = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( count < 0 );
+	PARANOID_ERR_IF( count > la->childrenCount );
+
+
+	/* CODE */
+	la->childrenCount -= count;
+
+	before = trotListNodePrev( la, node );
+
+	while ( count > 0 )
+	{
+		PARANOID_ERR_IF( node == &( la->headNode ) );
+
+		nextNode = node->next;
+
+		toRemove = (node->count) - i;
+		if ( toRemove > count )
+		{
+			toRemove = count;
+		}
+
+		/* how many items are after the ones we're removing? */
+		left = (node->count) - i - toRemove;
+
+		if ( node->kind == NODE_KIND_INT )
+		{
+			if ( left > 0 )
+			{
+				copyInts( node, i, node, i + toRemove, left );
+			}
+		}
+		else if ( node->kind == NODE_KIND_LIST )
+		{
+			freeRefs( program, &( NODE_LISTS( node )[ i ] ), toRemove );
+
+			if ( left > 0 )
+			{
+				memmove( &( NODE_LISTS( node )[ i ] ), &( NODE_LISTS( node )[ i + toRemove ] ), sizeof( TrotList * ) * left );
+			}
+
+			/* NULL out the slots that are now empty */
+			memset( &( NODE_LISTS( node )[ i + left ] ), 0, sizeof( TrotList * ) * toRemove );
+		}
+		else
+		{
+			freeSlots( program, &( NODE_SLOTS( node )[ i ] ), toRemove );
+
+			if ( left > 0 )
+			{
+				memmove( &( NODE_SLOTS( node )[ i ] ), &( NODE_SLOTS( node )[ i + toRemove ] ), sizeof( TrotListSlot ) * left );
+			}
+
+			memset( &( NODE_SLOTS( node )[ i + left ] ), 0, sizeof( TrotListSlot ) * toRemove );
+		}
+
+		nodeAddCount( la, node, -toRemove );
+
+		if ( node->count == 0 )
+		{
+			removeNode( program, la, node );
+		}
+
+		count -= toRemove;
+
+		/* next */
+		node = nextNode;
+		i = 0;
+	}
+
+	/* the nodes that were at either end of the run may be too empty now.
+	   they're the 2 nodes after before, if they're still here. */
+	node = before->next;
+	if ( node != &( la->headNode ) )
+	{
+		if ( node->next != &( la->headNode ) )
+		{
+			nodeMerge( program, la, node->next );
+		}
+
+		nodeMerge( program, la, before->next );
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Frees refs that have been taken out of a list.
+	\param[in] program List that maintains memory limit
+	\param[in] refs The refs.
+	\param[in] count How many refs there are.
+	\return void
+
+	When refs next to each other point to the same list, which happens a lot
+	with twins, only the last one has to check whether the list is still
+	reachable.
+*/
+static void freeRefs( TrotProgram *program, TrotList **refs, TROT_INT count )
+{
+	/* DATA */
+	TROT_INT j = 0;
+
+
+	/* CODE */
+	for ( j = 0; j < count; j += 1 )
+	{
+		refSetParent( refs[ j ], NULL );
+
+		if (    j + 1 < count
+		     && refs[ j + 1 ]->laPointsTo == refs[ j ]->laPointsTo
+		   )
+		{
+			refListRemove( program, refs[ j ]->laPointsTo, refs[ j ] );
+			refFree( program, refs[ j ] );
+		}
+		else
+		{
+			trotListFree( program, &( refs[ j ] ) );
+		}
+
+		refs[ j ] = NULL;
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Points the lists in a run of nodes at a new parent.
+	\param[in] program Program la is in.
+	\param[in] laFrom The list the nodes came from.
+	\param[in] la The new parent. The nodes must already be in its linked
+		list and its index.
+	\param[in] node First node of the run.
+	\param[in] end Node just after the run.
+	\return void
+
+	laFrom's inline node can't leave laFrom, so if it's in the run, its items
+	are moved into la's inline node, which takes its place. la's inline node
+	must not be in use. Moved lists are marked if the collector is marking,
+	since la may already have been scanned.
+*/
+static void reparentNodes( TrotProgram *program, TrotListActual *laFrom, TrotListActual *la, TrotListNode *node, TrotListNode *end )
+{
+	/* DATA */
+	TrotListNode *newNode = NULL;
+
+	TROT_INT j = 0;
+
+
+	/* CODE */
+	while ( node != end )
+	{
+		if ( node == &( laFrom->inlineNode ) )
+		{
+			PARANOID_ERR_IF( inlineNodeUsed( la ) );
+
+			newNode = &( la->inlineNode );
+			newNode->capacity = node->capacity;
+			newNode->width = node->width;
+
+			memcpy( la->inlineItems, laFrom->inlineItems, sizeof( la->inlineItems ) );
+
+			newNode->kind = node->kind;
+
+			nodeReplace( la, node, newNode );
+
+			node->count = 0;
+			node->width = 0;
+			node->kind = 0;
+
+			node = newNode;
+		}
+
+		if ( node->kind == NODE_KIND_LIST )
+		{
+			for ( j = 0; j < node->count; j += 1 )
+			{
+				refSetParent( NODE_LISTS( node )[ j ], la );
+				gcShade( program, NODE_LISTS( node )[ j ]->laPointsTo );
+			}
+		}
+		else if ( node->kind == NODE_KIND_MIXED )
+		{
+			for ( j = 0; j < node->count; j += 1 )
+			{
+				if ( NODE_SLOTS( node )[ j ].kind == NODE_KIND_LIST )
+				{
+					refSetParent( NODE_SLOTS( node )[ j ].u.l, la );
+					gcShade( program, NODE_SLOTS( node )[ j ].u.l->laPointsTo );
+				}
+			}
+		}
+
+		node = node->next;
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Unlinks a node from its list and frees it.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that node is in.
+	\param[in] node Node to remove. Its items must have already been removed.
+	\return void
+*/
+static void removeNode( TrotProgram *program, TrotListActual *la, TrotListNode *node )
+{
+	/* DATA */
+	TrotListNode *prevNode = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( node->count != 0 );
+
+
+	/* CODE */
+	if ( node == la->fingerNode )
+	{
+		la->fingerNode = NULL;
+	}
+
+	prevNode = trotListNodePrev( la, node );
+
+	indexRemoveNode( program, la, node );
+
+	prevNode->next = node->next;
+	if ( la->last == node )
+	{
+		la->last = prevNode;
+	}
+
+	nodeFree( program, la, node );
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Allocates a new node. The node's items are stored right after it,
+		in the same allocation.
+	\param[in] program List that maintains memory limit
+	\param[in] la List the node is for.
+	\param[in] kind NODE_KIND_INT, NODE_KIND_LIST, or NODE_KIND_MIXED.
+	\param[in] width For int nodes, how many bytes each int takes,
+		NODE_WIDTH_8, NODE_WIDTH_16, or NODE_WIDTH_FULL. Else 0.
+	\param[in] count How many items the caller is going to put in the node.
+	\param[out] node_A On success, the new node. It has no items, and isn't
+		linked into a list.
+	\return TROT_RC
+
+	If la is empty and count fits, la's inline node is given back instead,
+	and nothing is allocated. Else the node's capacity comes from
+	nodeCapacity.
+
+	Only int nodes aren't zeroed, since unused list slots and mixed slots
+	must be NULL.
+*/
+static TROT_RC nodeAlloc( TrotProgram *program, TrotListActual *la, TROT_INT kind, TROT_INT width, TROT_INT count, TrotListNode **node_A )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	char *block = NULL;
+	TrotListNode *newNode = NULL;
+
+	TROT_INT capacity = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node_A == NULL );
+	PARANOID_ERR_IF( (*node_A) != NULL );
+	PARANOID_ERR_IF(    kind == NODE_KIND_INT
+	                 && width != NODE_WIDTH_8
+	                 && width != NODE_WIDTH_16
+	                 && width != NODE_WIDTH_FULL
+	               );
+
+
+	/* CODE */
+	if (    la->headNode.next == &( la->headNode )
+	     && count <= inlineCapacity( kind )
+	     && ! inlineNodeUsed( la )
+	   )
+	{
+		newNode = &( la->inlineNode );
+		newNode->capacity = inlineCapacity( kind );
+
+		/* NODE_INTS and friends need inlineItems right after inlineNode */
+		PARANOID_ERR_IF( (void *)( newNode + 1 ) != (void *)la->inlineItems );
+
+		if ( kind != NODE_KIND_INT )
+		{
+			memset( la->inlineItems, 0, sizeof( la->inlineItems ) );
+		}
+	}
+	else
+	{
+		capacity = nodeCapacity( la->childrenCount, count );
+
+		if ( kind == NODE_KIND_INT )
+		{
+			TROT_MALLOC( block, nodeBytes( kind, width, capacity ) );
+		}
+		else
+		{
+			TROT_CALLOC( block, nodeBytes( kind, width, capacity ) );
+		}
+
+		newNode = (TrotListNode *)block;
+		newNode->capacity = capacity;
+	}
+
+	newNode->count = 0;
+	newNode->width = 0;
+	newNode->kind = kind;
+	newNode->next = NULL;
+	newNode->parent = NULL;
+	newNode->slot = 0;
+
+	if ( kind == NODE_KIND_INT )
+	{
+		newNode->width = width;
+	}
+
+	/* give back */
+	(*node_A) = newNode;
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Frees a node that was allocated with nodeAlloc.
+	\param[in] program List that maintains memory limit
+	\param[in] la List the node was for.
+	\param[in] node Node to free. Can be NULL.
+	\return void
+
+	If node is la's inline node, it's just marked as not used.
+*/
+static void nodeFree( TrotProgram *program, TrotListActual *la, TrotListNode *node )
+{
+	/* DATA */
+	char *block = (char *)node;
+
+
+	/* CODE */
+	if ( node == NULL )
+	{
+		return;
+	}
+
+	if ( node == &( la->inlineNode ) )
+	{
+		node->count = 0;
+		node->width = 0;
+		node->kind = 0;
+
+		return;
+	}
+
+	TROT_FREE( block, nodeBytes( nodeKind( node ), node->width, node->capacity ) );
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Puts a node in another node's place, in the linked list, in the
+		index, and as the finger.
+	\param[in] la List that oldNode is in.
+	\param[in] oldNode The node to take the place of. Isn't changed.
+	\param[in] newNode The node that takes its place. Must already have the
+		same items.
+	\return void
+*/
+static void nodeReplace( TrotListActual *la, TrotListNode *oldNode, TrotListNode *newNode )
+{
+	/* DATA */
+	TrotListNode *prevNode = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( oldNode == NULL );
+	PARANOID_ERR_IF( newNode == NULL );
+
+
+	/* CODE */
+	newNode->count = oldNode->count;
+
+	prevNode = trotListNodePrev( la, oldNode );
+	prevNode->next = newNode;
+	newNode->next = oldNode->next;
+	if ( la->last == oldNode )
+	{
+		la->last = newNode;
+	}
+
+	newNode->parent = oldNode->parent;
+	newNode->slot = oldNode->slot;
+	if ( newNode->parent != NULL )
+	{
+		newNode->parent->children[ newNode->slot ] = newNode;
+	}
+
+	if ( la->fingerNode == oldNode )
+	{
+		la->fingerNode = newNode;
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Moves the items of a node into a new normal node, which takes its
+		place.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that node is in.
+	\param[in,out] node The node. On success, this will point to the new
+		node.
+	\return TROT_RC
+
+	The new node gets the capacity nodeCapacity picks for la. This is how
+	the inline node is moved out when it fills up, and how nodes that are
+	too big are shrunk. On failure node is left the way it was.
+*/
+static TROT_RC nodeRealloc( TrotProgram *program, TrotListActual *la, TrotListNode **node )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListNode *oldNode = NULL;
+	TrotListNode *newNode = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( (*node) == NULL );
+	PARANOID_ERR_IF( nodeIsRun( *node ) );
+
+
+	/* CODE */
+	oldNode = (*node);
+
+	rc = nodeAlloc( program, la, nodeKind( oldNode ), oldNode->width, oldNode->count, &newNode );
+	ERR_IF_PASSTHROUGH;
+
+	PARANOID_ERR_IF( newNode == oldNode );
+	PARANOID_ERR_IF( newNode->capacity < oldNode->count );
+
+	if ( oldNode->kind == NODE_KIND_INT )
+	{
+		memcpy( NODE_INTS( newNode ), NODE_INTS( oldNode ), (oldNode->width) * (oldNode->count) );
+	}
+	else if ( oldNode->kind == NODE_KIND_LIST )
+	{
+		memcpy( NODE_LISTS( newNode ), NODE_LISTS( oldNode ), sizeof( TrotList * ) * (oldNode->count) );
+	}
+	else
+	{
+		memcpy( NODE_SLOTS( newNode ), NODE_SLOTS( oldNode ), sizeof( TrotListSlot ) * (oldNode->count) );
+	}
+
+	nodeReplace( la, oldNode, newNode );
+	nodeFree( program, la, oldNode );
+
+	/* give back */
+	(*node) = newNode;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Makes room for one more item in a full node.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that node is in.
+	\param[in,out] node The full node. If it's la's inline node and a normal
+		node is bigger, it's moved into a normal node first, and on success
+		this will point to the new node.
+	\return TROT_RC
+
+	If node is still full, it's split in half. The caller has to check if
+	the item now goes in node's next node.
+*/
+static TROT_RC nodeMakeRoom( TrotProgram *program, TrotListActual *la, TrotListNode **node )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( (*node) == NULL );
+
+
+	/* CODE */
+	if (    (*node) == &( la->inlineNode )
+	     && (*node)->capacity < TROT_NODE_SIZE
+	   )
+	{
+		rc = nodeRealloc( program, la, node );
+		ERR_IF_PASSTHROUGH;
+	}
+
+	if ( (*node)->count == (*node)->capacity )
+	{
+		rc = trotListNodeSplit( program, la, (*node), (*node)->capacity / 2 );
+		ERR_IF_PASSTHROUGH;
+	}
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Checks if a list's inline node is in use.
+	\param[in] la The list.
+	\return 1 if it's linked into la, or has been handed out by nodeAlloc,
+		else 0.
+*/
+static TROT_INT inlineNodeUsed( TrotListActual *la )
+{
+	return la->inlineNode.kind != 0;
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets how many items of a kind fit in a list's inline node.
+	\param[in] kind NODE_KIND_INT, NODE_KIND_LIST, or NODE_KIND_MIXED.
+	\return How many items fit. Never more than TROT_NODE_SIZE.
+*/
+static TROT_INT inlineCapacity( TROT_INT kind )
+{
+	/* DATA */
+	TROT_INT capacity = 0;
+
+
+	/* CODE */
+	if ( kind == NODE_KIND_INT )
+	{
+		capacity = ( sizeof( TrotList * ) * TROT_LIST_INLINE ) / sizeof( TROT_INT );
+	}
+	else if ( kind == NODE_KIND_LIST )
+	{
+		capacity = TROT_LIST_INLINE;
+	}
+	else
+	{
+		capacity = ( sizeof( TrotList * ) * TROT_LIST_INLINE ) / sizeof( TrotListSlot );
+	}
+
+	if ( capacity > TROT_NODE_SIZE )
+	{
+		capacity = TROT_NODE_SIZE;
+	}
+
+	return capacity;
+}
+
+/******************************************************************************/
+/*!
+	\brief Picks the capacity for a new node.
+	\param[in] size How many items are in the list the node is for.
+	\param[in] count How many items the caller is going to put in the node.
+	\return The capacity. Always TROT_NODE_SIZE times a power of 2, and never
+		more than TROT_NODE_SIZE_MAX unless TROT_NODE_SIZE is.
+
+	Nodes double in size every time the list doubles past TROT_NODE_GROWTH
+	nodes worth of items, and are always big enough for count.
+*/
+static TROT_INT nodeCapacity( TROT_INT size, TROT_INT count )
+{
+	/* DATA */
+	TROT_INT capacity = TROT_NODE_SIZE;
+
+
+	/* CODE */
+	while (    capacity < TROT_NODE_SIZE_MAX
+	        && (    capacity < count
+	             || capacity <= size / TROT_NODE_GROWTH
+	           )
+	      )
+	{
+		capacity *= 2;
+	}
+
+	return capacity;
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets how many bytes a node takes, including its items.
+	\param[in] kind NODE_KIND_INT, NODE_KIND_LIST, or NODE_KIND_MIXED.
+	\param[in] width For int nodes, how many bytes each int takes, or
+		NODE_WIDTH_RUN.
+	\param[in] capacity How many items fit in the node. Not used for runs.
+	\return Size in bytes.
+*/
+static TROT_INT nodeBytes( TROT_INT kind, TROT_INT width, TROT_INT capacity )
+{
+	if ( kind == NODE_KIND_INT && width == NODE_WIDTH_RUN )
+	{
+		return sizeof( TrotListNode ) + sizeof( TROT_INT );
+	}
+
+	if ( kind == NODE_KIND_INT )
+	{
+		return sizeof( TrotListNode ) + ( width * capacity );
+	}
+
+	if ( kind == NODE_KIND_LIST )
+	{
+		return sizeof( TrotListNode ) + ( sizeof( TrotList * ) * capacity );
+	}
+
+	return sizeof( TrotListNode ) + ( sizeof( TrotListSlot ) * capacity );
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets the kind of a node.
+	\param[in] node The node.
+	\return NODE_KIND_INT, NODE_KIND_LIST, or NODE_KIND_MIXED.
+*/
+static TROT_INT nodeKind( TrotListNode *node )
+{
+	PARANOID_ERR_IF(    node->kind != NODE_KIND_INT
+	                 && node->kind != NODE_KIND_LIST
+	                 && node->kind != NODE_KIND_MIXED
+	               );
+
+	return node->kind;
+}
+
+/******************************************************************************/
+/*!
+	\brief Merges a node with one of its neighbours if it's too empty.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that node is in.
+	\param[in] node Node that just had items removed. May be freed.
+	\return void
+
+	A node is too empty when it has less than TROT_NODE_UNDERFLOW items. If
+	node's items can move into the previous node and it has room, they do
+	and node is freed. Else if the next node's items can move into node and
+	fit, they do and the next node is freed.
+*/
+static void nodeMerge( TrotProgram *program, TrotListActual *la, TrotListNode *node )
+{
+	/* DATA */
+	TrotListNode *prevNode = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( node == &( la->headNode ) );
+
+
+	/* CODE */
+	if ( node->count >= TROT_NODE_UNDERFLOW )
+	{
+		return;
+	}
+
+	prevNode = trotListNodePrev( la, node );
+
+	if (    prevNode != &( la->headNode )
+	     && canMove( prevNode, node )
+	     && (prevNode->count) + (node->count) <= prevNode->capacity
+	   )
+	{
+		moveItems( program, la, prevNode, node, node->count );
+	}
+	else if (    node->next != &( la->headNode )
+	          && canMove( node, node->next )
+	          && (node->count) + (node->next->count) <= node->capacity
+	        )
+	{
+		moveItems( program, la, node, node->next, node->next->count );
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Moves items from the front of one node onto the end of the node
+		before it.
+	\param[in] program List that maintains memory limit
+	\param[in] la List the nodes are in.
+	\param[in] to Node to move the items onto. Must be from's previous node,
+		and canMove has to say the items can go in it.
+	\param[in] from Node to move the items from. Freed if it ends up empty.
+	\param[in] count How many items to move. to must have room for them.
+	\return void
+*/
+static void moveItems( TrotProgram *program, TrotListActual *la, TrotListNode *to, TrotListNode *from, TROT_INT count )
+{
+	/* DATA */
+	TROT_INT left = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( to == NULL );
+	PARANOID_ERR_IF( from == NULL );
+	PARANOID_ERR_IF( to->next != from );
+	PARANOID_ERR_IF( ! canMove( to, from ) );
+	PARANOID_ERR_IF( count > from->count );
+	PARANOID_ERR_IF( (to->count) + count > to->capacity );
+
+
+	/* CODE */
+	left = (from->count) - count;
+
+	if ( from->kind == NODE_KIND_INT )
+	{
+		copyInts( to, to->count, from, 0, count );
+		copyInts( from, 0, from, count, left );
+	}
+	else if ( from->kind == NODE_KIND_LIST )
+	{
+		memcpy( &( NODE_LISTS( to )[ to->count ] ), NODE_LISTS( from ), sizeof( TrotList * ) * count );
+		memmove( NODE_LISTS( from ), &( NODE_LISTS( from )[ count ] ), sizeof( TrotList * ) * left );
+		memset( &( NODE_LISTS( from )[ left ] ), 0, sizeof( TrotList * ) * count );
+	}
+	else
+	{
+		memcpy( &( NODE_SLOTS( to )[ to->count ] ), NODE_SLOTS( from ), sizeof( TrotListSlot ) * count );
+		memmove( NODE_SLOTS( from ), &( NODE_SLOTS( from )[ count ] ), sizeof( TrotListSlot ) * left );
+		memset( &( NODE_SLOTS( from )[ left ] ), 0, sizeof( TrotListSlot ) * count );
+	}
+
+	nodeAddCount( la, to, count );
+	nodeAddCount( la, from, -count );
+
+	if ( from->count == 0 )
+	{
+		removeNode( program, la, from );
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Checks if 2 nodes are the same kind.
+	\param[in] a First node.
+	\param[in] b Second node.
+	\return 1 if both are int nodes, both are list nodes, or both are mixed
+		nodes, else 0.
+*/
+static TROT_INT sameKind( TrotListNode *a, TrotListNode *b )
+{
+	return nodeKind( a ) == nodeKind( b );
+}
+
+/******************************************************************************/
+/*!
+	\brief Checks if an item of the other kind can be put into node.
+	\param[in] node The node.
+	\return 1 if node is already a mixed node, or is small enough that it's
+		worth turning into one, else 0.
+*/
+static TROT_INT canMix( TrotListNode *node )
+{
+	return node->kind == NODE_KIND_MIXED || node->count <= TROT_NODE_MIX;
+}
+
+/******************************************************************************/
+/*!
+	\brief Checks if items can be moved from one node into another without
+		changing the other node.
+	\param[in] to Node the items would move into.
+	\param[in] from Node the items would come from.
+	\return 1 if both are the same kind, and if they're int nodes, to isn't a
+		run and is at least as wide as from's ints, else 0.
+*/
+static TROT_INT canMove( TrotListNode *to, TrotListNode *from )
+{
+	return    sameKind( to, from )
+	       && (    to->kind != NODE_KIND_INT
+	            || ( ! nodeIsRun( to ) && to->width >= nodeIntsWidth( from ) )
+	          );
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets how many bytes an int needs in an int node.
+	\param[in] n The int.
+	\return NODE_WIDTH_8, NODE_WIDTH_16, or NODE_WIDTH_FULL.
+*/
+static TROT_INT intWidth( TROT_INT n )
+{
+	if ( n >= 0 && n <= 0xFF )
+	{
+		return NODE_WIDTH_8;
+	}
+
+	if ( n >= 0 && n <= 0xFFFF )
+	{
+		return NODE_WIDTH_16;
+	}
+
+	return NODE_WIDTH_FULL;
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets how many bytes each int needs for a run of ints to fit in an
+		int node.
+	\param[in] src The ints.
+	\param[in] count How many ints.
+	\return NODE_WIDTH_8, NODE_WIDTH_16, or NODE_WIDTH_FULL.
+*/
+static TROT_INT intsWidth( const TROT_INT *src, TROT_INT count )
+{
+	/* DATA */
+	TROT_INT width = NODE_WIDTH_8;
+
+	TROT_INT i = 0;
+
+
+	/* CODE */
+	while ( i < count && width != NODE_WIDTH_FULL )
+	{
+		if ( intWidth( src[ i ] ) > width )
+		{
+			width = intWidth( src[ i ] );
+		}
+
+		i += 1;
+	}
+
+	return width;
+}
+
+/******************************************************************************/
+/*!
+	\brief Puts an int into an int node.
+	\param[in] node The int node. Must be wide enough for n.
+	\param[in] i Where to put n.
+	\param[in] n The int.
+	\return void
+*/
+static void nodeSetInt( TrotListNode *node, TROT_INT i, TROT_INT n )
+{
+	/* PRECOND */
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( node->kind != NODE_KIND_INT );
+	PARANOID_ERR_IF( intWidth( n ) > node->width );
+
+
+	/* CODE */
+	if ( node->width == NODE_WIDTH_8 )
+	{
+		( (u8 *)NODE_INTS( node ) )[ i ] = (u8)n;
+	}
+	else if ( node->width == NODE_WIDTH_16 )
+	{
+		( (u16 *)NODE_INTS( node ) )[ i ] = (u16)n;
+	}
+	else
+	{
+		( (TROT_INT *)NODE_INTS( node ) )[ i ] = n;
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Copies ints from one int node to another, or inside the same node.
+	\param[in] to Node to copy into. Must be at least as wide as from's ints.
+	\param[in] toI Where to copy to in to.
+	\param[in] from Node to copy from.
+	\param[in] fromI Where to copy from in from.
+	\param[in] count How many ints to copy.
+	\return void
+
+	If to and from are the same node, the runs can overlap. A run node has
+	nothing to copy inside it, since all of its ints are the same.
+*/
+static void copyInts( TrotListNode *to, TROT_INT toI, TrotListNode *from, TROT_INT fromI, TROT_INT count )
+{
+	/* DATA */
+	TROT_INT i = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( to == NULL );
+	PARANOID_ERR_IF( from == NULL );
+	PARANOID_ERR_IF( count < 0 );
+
+
+	/* CODE */
+	if ( nodeIsRun( to ) )
+	{
+		PARANOID_ERR_IF( ! nodeIsRun( from ) );
+		PARANOID_ERR_IF( NODE_GET_INT( to, 0 ) != NODE_GET_INT( from, 0 ) );
+
+		return;
+	}
+
+	PARANOID_ERR_IF( to->width < nodeIntsWidth( from ) );
+
+	if ( to->width == from->width )
+	{
+		memmove( NODE_INT_AT( to, toI ), NODE_INT_AT( from, fromI ), (to->width) * count );
+
+		return;
+	}
+
+	for ( i = 0; i < count; i += 1 )
+	{
+		nodeSetInt( to, toI + i, NODE_GET_INT( from, fromI + i ) );
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Makes an int node wide enough for ints of a width.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that node is in.
+	\param[in,out] node The int node. If it has to be made wider and isn't
+		la's inline node, its ints are moved into a new wider node, and on
+		success this will point to the new node.
+	\param[in] width NODE_WIDTH_8, NODE_WIDTH_16, or NODE_WIDTH_FULL.
+	\return TROT_RC
+
+	The new node has at least as much room as the old one. The inline node
+	always has room for full width ints, so it's just made wider in place.
+	On failure node is left the way it was.
+*/
+static TROT_RC nodeWiden( TrotProgram *program, TrotListActual *la, TrotListNode **node, TROT_INT width )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListNode *oldNode = NULL;
+	TrotListNode *newNode = NULL;
+
+	TROT_INT i = 0;
+	TROT_INT n = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( (*node) == NULL );
+	PARANOID_ERR_IF( (*node)->kind != NODE_KIND_INT );
+	PARANOID_ERR_IF( nodeIsRun( *node ) );
+
+
+	/* CODE */
+	oldNode = (*node);
+
+	if ( oldNode->width >= width )
+	{
+		return TROT_RC_SUCCESS;
+	}
+
+	/* widen the inline node in place. going from the end, each int is
+	   moved to a spot that's at or past where it was, so we never write
+	   over an int we haven't moved yet. */
+	if ( oldNode == &( la->inlineNode ) )
+	{
+		PARANOID_ERR_IF( (oldNode->capacity) * width > (TROT_INT)sizeof( la->inlineItems ) );
+
+		i = oldNode->count;
+		while ( i > 0 )
+		{
+			i -= 1;
+
+			if ( oldNode->width == NODE_WIDTH_8 )
+			{
+				n = ( (u8 *)NODE_INTS( oldNode ) )[ i ];
+			}
+			else
+			{
+				n = ( (u16 *)NODE_INTS( oldNode ) )[ i ];
+			}
+
+			if ( width == NODE_WIDTH_16 )
+			{
+				( (u16 *)NODE_INTS( oldNode ) )[ i ] = (u16)n;
+			}
+			else
+			{
+				( (TROT_INT *)NODE_INTS( oldNode ) )[ i ] = n;
+			}
+		}
+
+		oldNode->width = width;
+
+		return TROT_RC_SUCCESS;
+	}
+
+	rc = nodeAlloc( program, la, NODE_KIND_INT, width, oldNode->capacity, &newNode );
+	ERR_IF_PASSTHROUGH;
+
+	PARANOID_ERR_IF( newNode == oldNode );
+	PARANOID_ERR_IF( newNode->capacity < oldNode->capacity );
+
+	copyInts( newNode, 0, oldNode, 0, oldNode->count );
+
+	nodeReplace( la, oldNode, newNode );
+	nodeFree( program, la, oldNode );
+
+	/* give back */
+	(*node) = newNode;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets how wide an int node has to be to take a node's ints.
+	\param[in] node The int node.
+	\return node's width, or for a run, the width its int needs.
+*/
+static TROT_INT nodeIntsWidth( TrotListNode *node )
+{
+	if ( nodeIsRun( node ) )
+	{
+		return intWidth( NODE_GET_INT( node, 0 ) );
+	}
+
+	return node->width;
+}
+
+/******************************************************************************/
+/*!
+	\brief Checks if a node is a run node.
+	\param[in] node The node.
+	\return 1 if node is a run node, else 0.
+*/
+static TROT_INT nodeIsRun( TrotListNode *node )
+{
+	return node->kind == NODE_KIND_INT && node->width == NODE_WIDTH_RUN;
+}
+
+/******************************************************************************/
+/*!
+	\brief Checks if every int in an int node is the same int.
+	\param[in] node The int node.
+	\param[in] n The int.
+	\return 1 if every int in node is n, else 0.
+*/
+static TROT_INT nodeIsAll( TrotListNode *node, TROT_INT n )
+{
+	/* DATA */
+	TROT_INT i = 0;
+
+
+	/* CODE */
+	i = node->count;
+	while ( i > 0 )
+	{
+		i -= 1;
+
+		if ( NODE_GET_INT( node, i ) != n )
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/******************************************************************************/
+/*!
+	\brief Allocates a new run node.
+	\param[in] program List that maintains memory limit
+	\param[in] n The int the run is made of.
+	\param[out] node_A On success, the new run node. Its count is 0, and it
+		isn't linked into a list.
+	\return TROT_RC
+
+	Run nodes are never a list's inline node.
+*/
+static TROT_RC nodeAllocRun( TrotProgram *program, TROT_INT n, TrotListNode **node_A )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	char *block = NULL;
+	TrotListNode *newNode = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( node_A == NULL );
+	PARANOID_ERR_IF( (*node_A) != NULL );
+
+
+	/* CODE */
+	TROT_MALLOC( block, nodeBytes( NODE_KIND_INT, NODE_WIDTH_RUN, 0 ) );
+
+	newNode = (TrotListNode *)block;
+
+	newNode->count = 0;
+	newNode->capacity = 0;
+	newNode->kind = NODE_KIND_INT;
+	newNode->next = NULL;
+	newNode->parent = NULL;
+	newNode->slot = 0;
+	newNode->width = NODE_WIDTH_RUN;
+
+	( (TROT_INT *)NODE_INTS( newNode ) )[ 0 ] = n;
+
+	/* give back */
+	(*node_A) = newNode;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Turns an int node whose ints are all the same into a run node.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that node is in.
+	\param[in,out] node The int node. On success, this will point to the run
+		node that took its place.
+	\return TROT_RC
+*/
+static TROT_RC nodeMakeRun( TrotProgram *program, TrotListActual *la, TrotListNode **node )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListNode *oldNode = NULL;
+	TrotListNode *newNode = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( (*node) == NULL );
+	PARANOID_ERR_IF( (*node)->kind != NODE_KIND_INT );
+	PARANOID_ERR_IF( (*node)->count == 0 );
+	PARANOID_ERR_IF( ! nodeIsAll( (*node), NODE_GET_INT( (*node), 0 ) ) );
+
+
+	/* CODE */
+	oldNode = (*node);
+
+	rc = nodeAllocRun( program, NODE_GET_INT( oldNode, 0 ), &newNode );
+	ERR_IF_PASSTHROUGH;
+
+	nodeReplace( la, oldNode, newNode );
+	newNode->capacity = newNode->count;
+
+	nodeFree( program, la, oldNode );
+
+	/* give back */
+	(*node) = newNode;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Makes an item in a run node be in a normal int node, so it can be
+		changed.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that node is in.
+	\param[in] node The run node.
+	\param[in] i Where the item is in node.
+	\return TROT_RC
+
+	Up to TROT_NODE_SIZE items around the item are split off of the run into
+	a normal node. What's left of the run before and after them stays as
+	runs. The caller has to find the item's node again after this. On
+	failure the list may have been split into more runs, but its items
+	haven't changed.
+*/
+static TROT_RC nodeSplitRun( TrotProgram *program, TrotListActual *la, TrotListNode *node, TROT_INT i )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListNode *newNode = NULL;
+
+	TROT_INT n = 0;
+	TROT_INT count = 0;
+	TROT_INT start = 0;
+	TROT_INT j = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( ! nodeIsRun( node ) );
+	PARANOID_ERR_IF( i < 0 );
+	PARANOID_ERR_IF( i >= node->count );
+
+
+	/* CODE */
+	n = NODE_GET_INT( node, 0 );
+
+	/* which items go in the normal node? */
+	count = TROT_NODE_SIZE;
+	if ( count > node->count )
+	{
+		count = node->count;
+	}
+
+	start = i - ( count / 2 );
+	if ( start > (node->count) - count )
+	{
+		start = (node->count) - count;
+	}
+	if ( start < 0 )
+	{
+		start = 0;
+	}
+
+	/* split off the rest of the run after them, and before them */
+	if ( start + count < node->count )
+	{
+		rc = trotListNodeSplit( program, la, node, start + count );
+		ERR_IF_PASSTHROUGH;
+	}
+
+	if ( start > 0 )
+	{
+		rc = trotListNodeSplit( program, la, node, start );
+		ERR_IF_PASSTHROUGH;
+
+		node = node->next;
+	}
+
+	/* and put them in a normal node */
+	rc = nodeAlloc( program, la, NODE_KIND_INT, intWidth( n ), count, &newNode );
+	ERR_IF_PASSTHROUGH;
+
+	for ( j = 0; j < count; j += 1 )
+	{
+		nodeSetInt( newNode, j, n );
+	}
+
+	nodeReplace( la, node, newNode );
+	nodeFree( program, la, node );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Turns an int or list node into a mixed node.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that node is in.
+	\param[in,out] node Node to turn into a mixed node. Noop if it already is
+		one. Since a node's items are in the same allocation as the node, the
+		node is replaced, and on success this will point to the new node.
+	\return TROT_RC
+
+	la's inline node is changed in place instead, if its items fit. On
+	failure node is left the way it was.
+*/
+static TROT_RC nodeMakeMixed( TrotProgram *program, TrotListActual *la, TrotListNode **node )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListNode *oldNode = NULL;
+	TrotListNode *newNode = NULL;
+
+	TrotList *inlineItems[ TROT_LIST_INLINE ];
+	TrotListSlot *slots = NULL;
+
+	TROT_INT i = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( (*node) == NULL );
+
+
+	/* CODE */
+	oldNode = (*node);
+
+	if ( oldNode->kind == NODE_KIND_MIXED )
+	{
+		return TROT_RC_SUCCESS;
+	}
+
+	/* the inline node is changed in place if its items still fit, else it
+	   becomes a normal node first */
+	if (    oldNode == &( la->inlineNode )
+	     && oldNode->count > inlineCapacity( NODE_KIND_MIXED )
+	   )
+	{
+		rc = nodeRealloc( program, la, &oldNode );
+		ERR_IF_PASSTHROUGH;
+
+		(*node) = oldNode;
+	}
+
+	if ( oldNode == &( la->inlineNode ) )
+	{
+		memset( inlineItems, 0, sizeof( inlineItems ) );
+		slots = (TrotListSlot *)inlineItems;
+	}
+	else
+	{
+		rc = nodeAlloc( program, la, NODE_KIND_MIXED, 0, oldNode->count, &newNode );
+		ERR_IF_PASSTHROUGH;
+
+		slots = NODE_SLOTS( newNode );
+	}
+
+	/* copy items */
+	if ( oldNode->kind == NODE_KIND_INT )
+	{
+		for ( i = 0; i < oldNode->count; i += 1 )
+		{
+			slots[ i ].kind = NODE_KIND_INT;
+			slots[ i ].u.n = NODE_GET_INT( oldNode, i );
+		}
+	}
+	else
+	{
+		for ( i = 0; i < oldNode->count; i += 1 )
+		{
+			slots[ i ].kind = NODE_KIND_LIST;
+			slots[ i ].u.l = NODE_LISTS( oldNode )[ i ];
+		}
+	}
+
+	if ( newNode == NULL )
+	{
+		memcpy( la->inlineItems, inlineItems, sizeof( inlineItems ) );
+
+		oldNode->capacity = inlineCapacity( NODE_KIND_MIXED );
+		oldNode->width = 0;
+		oldNode->kind = NODE_KIND_MIXED;
+
+		return TROT_RC_SUCCESS;
+	}
+
+	/* take oldNode's place */
+	nodeReplace( la, oldNode, newNode );
+
+	nodeFree( program, la, oldNode );
+
+	/* give back */
+	(*node) = newNode;
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Inserts an int or list into a node, turning the node into a mixed
+		node first.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that node is in.
+	\param[in] node Node to insert into. Split first if it's full.
+	\param[in] i Where to insert in node.
+	\param[in] n Int to insert, if l is NULL.
+	\param[in] l List to twin and insert, or NULL to insert n.
+	\return TROT_RC
+
+	Doesn't change la's childrenCount.
+*/
+static TROT_RC mixedInsert( TrotProgram *program, TrotListActual *la, TrotListNode *node, TROT_INT i, TROT_INT n, TrotList *l )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotList *newL = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( i < 0 );
+	PARANOID_ERR_IF( i > node->count );
+
+
+	/* CODE */
+	if ( l != NULL )
+	{
+		rc = trotListTwin( program, l, &newL );
+		ERR_IF_PASSTHROUGH;
+	}
+
+	rc = nodeMakeMixed( program, la, &node );
+	ERR_IF_PASSTHROUGH;
+
+	/* If node is full */
+	if ( node->count == node->capacity )
+	{
+		rc = nodeMakeRoom( program, la, &node );
+		ERR_IF_PASSTHROUGH;
+
+		/* Since node has been split, we may need to go to next node. */
+		if ( i > node->count )
+		{
+			i -= node->count;
+			node = node->next;
+		}
+	}
+
+	/* make room */
+	memmove( &( NODE_SLOTS( node )[ i + 1 ] ), &( NODE_SLOTS( node )[ i ] ), sizeof( TrotListSlot ) * ( (node->count) - i ) );
+
+	/* insert */
+	if ( newL != NULL )
+	{
+		NODE_SLOTS( node )[ i ].kind = NODE_KIND_LIST;
+		NODE_SLOTS( node )[ i ].u.l = newL;
+		refSetParent( newL, la );
+		newL = NULL;
+	}
+	else
+	{
+		NODE_SLOTS( node )[ i ].kind = NODE_KIND_INT;
+		NODE_SLOTS( node )[ i ].u.n = n;
+	}
+
+	nodeAddCount( la, node, 1 );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &newL );
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Replaces an item in a node with an int or list, turning the node
+		into a mixed node first.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that node is in.
+	\param[in] node Node that holds the item.
+	\param[in] i Where the item is in node.
+	\param[in] n Int to put in, if l is NULL.
+	\param[in] l List to twin and put in, or NULL to put in n.
+	\return TROT_RC
+*/
+static TROT_RC mixedReplace( TrotProgram *program, TrotListActual *la, TrotListNode *node, TROT_INT i, TROT_INT n, TrotList *l )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotList *newL = NULL;
+	TrotList *tempL = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( i < 0 );
+	PARANOID_ERR_IF( i >= node->count );
+
+
+	/* CODE */
+	if ( l != NULL )
+	{
+		rc = trotListTwin( program, l, &newL );
+		ERR_IF_PASSTHROUGH;
+	}
+
+	rc = nodeMakeMixed( program, la, &node );
+	ERR_IF_PASSTHROUGH;
+
+	/* free old */
+	if ( NODE_SLOTS( node )[ i ].kind == NODE_KIND_LIST )
+	{
+		tempL = NODE_SLOTS( node )[ i ].u.l;
+		refSetParent( tempL, NULL );
+		trotListFree( program, &tempL );
+	}
+
+	/* replace with new */
+	if ( newL != NULL )
+	{
+		NODE_SLOTS( node )[ i ].kind = NODE_KIND_LIST;
+		NODE_SLOTS( node )[ i ].u.l = newL;
+		refSetParent( newL, la );
+		newL = NULL;
+	}
+	else
+	{
+		NODE_SLOTS( node )[ i ].kind = NODE_KIND_INT;
+		NODE_SLOTS( node )[ i ].u.n = n;
+	}
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &newL );
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Takes a slot out of a mixed node, shifting down the slots after
+		it.
+	\param[in] node The mixed node.
+	\param[in] i Which slot to take out. If it holds a list, the list must
+		have already been taken care of.
+	\return void
+
+	Doesn't change node's count.
+*/
+static void mixedRemove( TrotListNode *node, TROT_INT i )
+{
+	/* PRECOND */
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( node->kind != NODE_KIND_MIXED );
+	PARANOID_ERR_IF( i < 0 );
+	PARANOID_ERR_IF( i >= node->count );
+
+
+	/* CODE */
+	memmove( &( NODE_SLOTS( node )[ i ] ), &( NODE_SLOTS( node )[ i + 1 ] ), sizeof( TrotListSlot ) * ( (node->count) - i - 1 ) );
+	memset( &( NODE_SLOTS( node )[ (node->count) - 1 ] ), 0, sizeof( TrotListSlot ) );
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Frees the lists in slots that have been taken out of a list.
+	\param[in] program List that maintains memory limit
+	\param[in] slots The slots.
+	\param[in] count How many slots there are.
+	\return void
+*/
+static void freeSlots( TrotProgram *program, TrotListSlot *slots, TROT_INT count )
+{
+	/* DATA */
+	TROT_INT j = 0;
+
+
+	/* CODE */
+	for ( j = 0; j < count; j += 1 )
+	{
+		if ( slots[ j ].kind == NODE_KIND_LIST )
+		{
+			refSetParent( slots[ j ].u.l, NULL );
+			trotListFree( program, &( slots[ j ].u.l ) );
+		}
+
+		memset( &( slots[ j ] ), 0, sizeof( TrotListSlot ) );
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets the list ref at i in a node.
+	\param[in] node A NODE_KIND_LIST or NODE_KIND_MIXED node.
+	\param[in] i Which item.
+	\return The ref, or NULL if the item is an int.
+*/
+static TrotList *nodeListAt( TrotListNode *node, TROT_INT i )
+{
+	/* PRECOND */
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( node->kind != NODE_KIND_LIST && node->kind != NODE_KIND_MIXED );
+	PARANOID_ERR_IF( i < 0 || i >= node->count );
+
+
+	/* CODE */
+	if ( node->kind == NODE_KIND_LIST )
+	{
+		return NODE_LISTS( node )[ i ];
+	}
+
+	if ( NODE_SLOTS( node )[ i ].kind == NODE_KIND_LIST )
+	{
+		return NODE_SLOTS( node )[ i ].u.l;
+	}
+
+	return NULL;
+}
+
+/******************************************************************************/
+/*!
+	\brief Finds the node that holds index.
+	\param[in] la List to look in.
+	\param[in] index Index to find. Must be in range.
+	\param[out] node On return, the node that holds index.
+	\param[out] count On return, how many items are in the nodes before node.
+	\return void
+
+	Looks in the list's finger and the nodes next to it first, which makes
+	walking a list in order O(1) per step, and then in the first and last
+	nodes, which makes stack-like use of a list O(1). Otherwise walks down
+	the index, which is O(log n) in the number of nodes. Either way, node
+	becomes the new finger.
+*/
+void trotListFindNode( TrotListActual *la, TROT_INT index, TrotListNode **node, TROT_INT *count )
+{
+	/* DATA */
+	TrotListNode *finger = NULL;
+	TrotListNode *prevNode = NULL;
+	TROT_INT start = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( index <= 0 );
+	PARANOID_ERR_IF( index > la->childrenCount );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( count == NULL );
+
+
+	/* CODE */
+	finger = la->fingerNode;
+	start = la->fingerStart;
+
+	/* the node before the finger, if that's where we're looking */
+	if ( finger != NULL && index <= start )
+	{
+		prevNode = trotListNodePrev( la, finger );
+	}
+
+	/* is it in the finger, or in the nodes on either side of it? */
+	if (    finger != NULL
+	     && index > start
+	     && index <= start + finger->count
+	   )
+	{
+		/* finger stays the same */
+	}
+	else if (    finger != NULL
+	          && index > start + finger->count
+	          && finger->next != &( la->headNode )
+	          && index <= start + finger->count + finger->next->count
+	        )
+	{
+		start += finger->count;
+		finger = finger->next;
+	}
+	else if (    prevNode != NULL
+	          && prevNode != &( la->headNode )
+	          && index > start - prevNode->count
+	        )
+	{
+		finger = prevNode;
+		start -= finger->count;
+	}
+	/* is it in the last node? this makes index -1 O(1) */
+	else if ( index > la->childrenCount - la->last->count )
+	{
+		finger = la->last;
+		start = la->childrenCount - finger->count;
+	}
+	/* is it in the first node? */
+	else if ( index <= la->headNode.next->count )
+	{
+		finger = la->headNode.next;
+		start = 0;
+	}
+	else
+	{
+		findNodeInIndex( la, index, &finger, &start );
+	}
+
+	la->fingerNode = finger;
+	la->fingerStart = start;
+
+	/* give back */
+	(*node) = finger;
+	(*count) = start;
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Finds the node before a node.
+	\param[in] la List that node is in.
+	\param[in] node The node, or la's headNode.
+	\return The node before node, which is la's headNode if node is the first
+		node. If node is la's headNode, the last node, which is la's headNode
+		if la has no nodes.
+
+	Nodes only point forward, so this goes through the index. It's O(1) when
+	node isn't the first child of its index node, which is most of the time,
+	else O(log n) in the number of nodes. la's linked list and index must
+	agree when this is called.
+*/
+TrotListNode *trotListNodePrev( TrotListActual *la, TrotListNode *node )
+{
+	/* DATA */
+	TrotListIndexNode *in = NULL;
+	TROT_INT slot = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+
+
+	/* CODE */
+	if ( node == &( la->headNode ) )
+	{
+		return la->last;
+	}
+
+	/* a node that isn't in an index is the only node */
+	if ( node->parent == NULL )
+	{
+		PARANOID_ERR_IF( la->headNode.next != node );
+
+		return &( la->headNode );
+	}
+
+	/* go up until there's something to the left */
+	in = node->parent;
+	slot = node->slot;
+	while ( slot == 0 )
+	{
+		if ( in->parent == NULL )
+		{
+			return &( la->headNode );
+		}
+
+		slot = in->slot;
+		in = in->parent;
+	}
+
+	/* and then down the right side of it */
+	slot -= 1;
+	while ( in->level > 1 )
+	{
+		in = (TrotListIndexNode *)in->children[ slot ];
+		slot = (in->used) - 1;
+	}
+
+	return (TrotListNode *)in->children[ slot ];
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets the kind of an item in a node.
+	\param[in] node The node.
+	\param[in] i Where the item is in node.
+	\return NODE_KIND_INT or NODE_KIND_LIST
+*/
+TROT_INT trotListNodeGetKind( TrotListNode *node, TROT_INT i )
+{
+	/* PRECOND */
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( i < 0 );
+	PARANOID_ERR_IF( i >= node->count );
+
+
+	/* CODE */
+	if ( node->kind == NODE_KIND_INT )
+	{
+		return NODE_KIND_INT;
+	}
+
+	if ( node->kind == NODE_KIND_LIST )
+	{
+		return NODE_KIND_LIST;
+	}
+
+	return NODE_SLOTS( node )[ i ].kind;
+}
+
+/******************************************************************************/
+/*!
+	\brief Finds the node that holds index by walking down the index.
+	\param[in] la List to look in.
+	\param[in] index Index to find. Must be in range.
+	\param[out] node On return, the node that holds index.
+	\param[out] count On return, how many items are in the nodes before node.
+	\return void
+
+	At each level, the children are scanned from whichever end is nearer to
+	index.
+*/
+static void findNodeInIndex( TrotListActual *la, TROT_INT index, TrotListNode **node, TROT_INT *count )
+{
+	/* DATA */
+	TrotListIndexNode *in = NULL;
+
+	TROT_INT total = 0;
+	TROT_INT end = 0;
+
+	TROT_INT i = 0;
+
+
+	/* CODE */
+	(*count) = 0;
+	total = la->childrenCount;
+
+	/* if there's no index, there's only 1 node */
+	in = la->indexRoot;
+	if ( in == NULL )
+	{
+		(*node) = la->headNode.next;
+
+		PARANOID_ERR_IF( (*node) == &( la->headNode ) );
+
+		return;
+	}
+
+	/* walk down the index */
+	while ( 1 )
+	{
+		/* nearer the end? scan from the right */
+		if ( index - (*count) > total / 2 )
+		{
+			end = (*count) + total;
+
+			i = in->used - 1;
+			while ( end - in->counts[ i ] >= index )
+			{
+				end -= in->counts[ i ];
+				i -= 1;
+
+				PARANOID_ERR_IF( i < 0 );
+			}
+
+			(*count) = end - in->counts[ i ];
+		}
+		/* else scan from the left */
+		else
+		{
+			i = 0;
+			while ( (*count) + in->counts[ i ] < index )
+			{
+				(*count) += in->counts[ i ];
+				i += 1;
+
+				PARANOID_ERR_IF( i >= in->used );
+			}
+		}
+
+		total = in->counts[ i ];
+
+		if ( in->level == 1 )
+		{
+			(*node) = (TrotListNode *)in->children[ i ];
+			return;
+		}
+
+		in = (TrotListIndexNode *)in->children[ i ];
+	}
+}
+
+/******************************************************************************/
+/*!
+	\brief Changes a node's count, and updates the index and finger to match.
+	\param[in] la List that node is in.
+	\param[in] node The node.
+	\param[in] delta How much to add to node's count.
+	\return void
+*/
+static void nodeAddCount( TrotListActual *la, TrotListNode *node, TROT_INT delta )
+{
+	/* PRECOND */
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+
+
+	/* CODE */
+	node->count += delta;
+
+	if ( nodeIsRun( node ) )
+	{
+		node->capacity = node->count;
+	}
+
+	indexAddCount( node->parent, node->slot, delta );
+
+	/* keep finger's start right. if we can't cheaply tell whether node is
+	   before the finger, just drop the finger. */
+	if (    la->fingerNode == NULL
+	     || node == la->fingerNode
+	     || node == la->fingerNode->next
+	     || node == la->last
+	   )
+	{
+		/* node is the finger or after it, so finger's start doesn't change */
+	}
+	else if (    node->next == la->fingerNode
+	          || node == la->headNode.next
+	        )
+	{
+		la->fingerStart += delta;
+	}
+	else
+	{
+		la->fingerNode = NULL;
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Links a node into a list after prevNode, and into the list's index.
+	\param[in] program List that maintains memory limit
+	\param[in] la List to link into.
+	\param[in] prevNode Node to link after. Can be la's head.
+	\param[in] node Node to link. Its count should already be set.
+	\return TROT_RC
+
+	Any index nodes that may be needed are allocated before anything is
+	changed, so on failure the list is left untouched.
+*/
+static TROT_RC linkNode( TrotProgram *program, TrotListActual *la, TrotListNode *prevNode, TrotListNode *node )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListIndexNode *in = NULL;
+	TROT_INT slot = 0;
+
+	TrotListIndexNode *spares = NULL;
+	TrotListIndexNode *newIndexNode = NULL;
+
+	TrotListNode *other = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( prevNode == NULL );
+	PARANOID_ERR_IF( node == NULL );
+
+
+	/* CODE */
+	node->parent = NULL;
+	node->slot = 0;
+
+	/* if list has no nodes, we don't need an index yet */
+	if ( la->headNode.next == &( la->headNode ) )
+	{
+		/* nothing to do */
+	}
+	/* if list has 1 node, we need to create the index */
+	else if ( la->indexRoot == NULL )
+	{
+		TROT_MALLOC( newIndexNode, 1 );
+
+		newIndexNode->level = 1;
+		newIndexNode->used = 2;
+		newIndexNode->parent = NULL;
+		newIndexNode->slot = 0;
+
+		other = la->headNode.next;
+		if ( prevNode == &( la->headNode ) )
+		{
+			indexSetChild( newIndexNode, 0, node, node->count );
+			indexSetChild( newIndexNode, 1, other, other->count );
+		}
+		else
+		{
+			indexSetChild( newIndexNode, 0, other, other->count );
+			indexSetChild( newIndexNode, 1, node, node->count );
+		}
+
+		la->indexRoot = newIndexNode;
+		newIndexNode = NULL;
+	}
+	else
+	{
+		/* find where node goes in the index */
+		if ( prevNode == &( la->headNode ) )
+		{
+			in = la->headNode.next->parent;
+			slot = 0;
+		}
+		else
+		{
+			in = prevNode->parent;
+			slot = prevNode->slot + 1;
+		}
+
+		/* allocate the index nodes we'll need if we have to split, so we
+		   can't fail halfway through */
+		rc = indexAllocSpares( program, in, &spares );
+		ERR_IF_PASSTHROUGH;
+
+		/* insert with a count of 0, and then add node's count */
+		indexInsert( la, in, slot, node, 0, &spares );
+		indexAddCount( node->parent, node->slot, node->count );
+
+		PARANOID_ERR_IF( spares != NULL );
+	}
+
+	/* keep finger's start right */
+	if (    la->fingerNode == NULL
+	     || prevNode == la->fingerNode
+	     || prevNode == la->last
+	   )
+	{
+		/* node goes after the finger, so finger's start doesn't change */
+	}
+	else if (    prevNode->next == la->fingerNode
+	          || prevNode == &( la->headNode )
+	        )
+	{
+		la->fingerStart += node->count;
+	}
+	else
+	{
+		la->fingerNode = NULL;
+	}
+
+	/* link into list */
+	node->next = prevNode->next;
+	prevNode->next = node;
+
+	if ( la->last == prevNode )
+	{
+		la->last = node;
+	}
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Puts a child into an index node, and points the child back at it.
+	\param[in] in The index node.
+	\param[in] slot Where in in's children to put the child.
+	\param[in] child A TrotListNode if in's level is 1, else a
+		TrotListIndexNode.
+	\param[in] count How many items are under child.
+	\return void
+*/
+static void indexSetChild( TrotListIndexNode *in, TROT_INT slot, void *child, TROT_INT count )
+{
+	/* PRECOND */
+	PARANOID_ERR_IF( in == NULL );
+	PARANOID_ERR_IF( slot < 0 );
+	PARANOID_ERR_IF( slot >= TROT_INDEX_SIZE );
+	PARANOID_ERR_IF( child == NULL );
+
+
+	/* CODE */
+	in->children[ slot ] = child;
+	in->counts[ slot ] = count;
+
+	if ( in->level == 1 )
+	{
+		((TrotListNode *)child)->parent = in;
+		((TrotListNode *)child)->slot = slot;
+	}
+	else
+	{
+		((TrotListIndexNode *)child)->parent = in;
+		((TrotListIndexNode *)child)->slot = slot;
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Inserts a child into an index node, splitting the index node if
+		it's full.
+	\param[in] la List that owns the index.
+	\param[in] in The index node.
+	\param[in] slot Where in in's children to insert.
+	\param[in] child Child to insert.
+	\param[in] count How many items are under child. These must already be
+		counted in in's ancestors, or be 0.
+	\param[in] spares Preallocated index nodes to use for splits, chained
+		through their parent pointers.
+	\return void
+*/
+static void indexInsert( TrotListActual *la, TrotListIndexNode *in, TROT_INT slot, void *child, TROT_INT count, TrotListIndexNode **spares )
+{
+	/* DATA */
+	TrotListIndexNode *sibling = NULL;
+	TrotListIndexNode *newRoot = NULL;
+
+	TROT_INT keep = 0;
+	TROT_INT total = 0;
+	TROT_INT siblingTotal = 0;
+
+	TROT_INT i = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( in == NULL );
+	PARANOID_ERR_IF( slot < 0 );
+	PARANOID_ERR_IF( slot > in->used );
+	PARANOID_ERR_IF( child == NULL );
+	PARANOID_ERR_IF( spares == NULL );
+
+
+	/* CODE */
+	/* if there's room, shift over and insert */
+	if ( in->used < TROT_INDEX_SIZE )
+	{
+		i = in->used;
+		while ( i > slot )
+		{
+			indexSetChild( in, i, in->children[ i - 1 ], in->counts[ i - 1 ] );
+			i -= 1;
+		}
+
+		indexSetChild( in, slot, child, count );
+		in->used += 1;
+
+		return;
+	}
+
+	/* no room, so split in half */
+	PARANOID_ERR_IF( (*spares) == NULL );
+	sibling = (*spares);
+	(*spares) = sibling->parent;
+
+	keep = TROT_INDEX_SIZE / 2;
+
+	sibling->level = in->level;
+	sibling->used = TROT_INDEX_SIZE - keep;
+	sibling->parent = NULL;
+	sibling->slot = 0;
+
+	i = keep;
+	while ( i < TROT_INDEX_SIZE )
+	{
+		indexSetChild( sibling, i - keep, in->children[ i ], in->counts[ i ] );
+		i += 1;
+	}
+
+	in->used = keep;
+
+	/* now there's room */
+	if ( slot <= keep )
+	{
+		indexInsert( la, in, slot, child, count, spares );
+	}
+	else
+	{
+		indexInsert( la, sibling, slot - keep, child, count, spares );
+	}
+
+	/* *** */
+	for ( i = 0; i < sibling->used; i += 1 )
+	{
+		siblingTotal += sibling->counts[ i ];
+	}
+
+	/* put sibling in after in */
+	if ( in->parent == NULL )
+	{
+		PARANOID_ERR_IF( la->indexRoot != in );
+		PARANOID_ERR_IF( (*spares) == NULL );
+
+		newRoot = (*spares);
+		(*spares) = newRoot->parent;
+
+		for ( i = 0; i < in->used; i += 1 )
+		{
+			total += in->counts[ i ];
+		}
+
+		newRoot->level = in->level + 1;
+		newRoot->used = 2;
+		newRoot->parent = NULL;
+		newRoot->slot = 0;
+
+		indexSetChild( newRoot, 0, in, total );
+		indexSetChild( newRoot, 1, sibling, siblingTotal );
+
+		la->indexRoot = newRoot;
+	}
+	else
+	{
+		/* sibling's items move from in's count to sibling's count */
+		in->parent->counts[ in->slot ] -= siblingTotal;
+		indexInsert( la, in->parent, in->slot + 1, sibling, siblingTotal, spares );
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Adds delta to the count at slot in an index node, and to the counts
+		of all its ancestors.
+	\param[in] in The index node. Can be NULL, and this will be a noop.
+	\param[in] slot Which count to change.
+	\param[in] delta How much to add.
+	\return void
+*/
+static void indexAddCount( TrotListIndexNode *in, TROT_INT slot, TROT_INT delta )
+{
+	/* CODE */
+	while ( in != NULL )
+	{
+		in->counts[ slot ] += delta;
+
+		slot = in->slot;
+		in = in->parent;
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Removes a node from its list's index.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that owns the index.
+	\param[in] node Node to remove.
+	\return void
+
+	Index nodes that become empty are freed. If the root is left with only 1
+	child, the child becomes the root.
+*/
+static void indexRemoveNode( TrotProgram *program, TrotListActual *la, TrotListNode *node )
+{
+	/* DATA */
+	TrotListIndexNode *in = NULL;
+	TrotListIndexNode *parent = NULL;
+	TROT_INT slot = 0;
+
+	TROT_INT i = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( node == NULL );
+
+
+	/* CODE */
+	/* take node's items out of the counts */
+	indexAddCount( node->parent, node->slot, -(node->count) );
+
+	/* remove node, and any index nodes that become empty */
+	in = node->parent;
+	slot = node->slot;
+	while ( in != NULL )
+	{
+		i = slot;
+		while ( i < in->used - 1 )
+		{
+			indexSetChild( in, i, in->children[ i + 1 ], in->counts[ i + 1 ] );
+			i += 1;
+		}
+		in->used -= 1;
+
+		if ( in->used > 0 )
+		{
+			break;
+		}
+
+		PARANOID_ERR_IF( in == la->indexRoot );
+
+		parent = in->parent;
+		slot = in->slot;
+
+		TROT_FREE( in, 1 );
+
+		in = parent;
+	}
+
+	indexShrinkRoot( program, la );
+
+	node->parent = NULL;
+	node->slot = 0;
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Allocates the index nodes that inserting into in could need for
+		splits, so the insert can't fail halfway through.
+	\param[in] program List that maintains memory limit
+	\param[in] in Index node that will be inserted into.
+	\param[out] spares On success, the allocated index nodes, chained
+		through their parent pointers. May be NULL if none are needed.
+	\return TROT_RC
+*/
+static TROT_RC indexAllocSpares( TrotProgram *program, TrotListIndexNode *in, TrotListIndexNode **spares )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListIndexNode *newIndexNode = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( spares == NULL );
+	PARANOID_ERR_IF( (*spares) != NULL );
+
+
+	/* CODE */
+	while ( in != NULL && in->used == TROT_INDEX_SIZE )
+	{
+		TROT_MALLOC( newIndexNode, 1 );
+		newIndexNode->parent = (*spares);
+		(*spares) = newIndexNode;
+		newIndexNode = NULL;
+
+		/* if we're splitting the root, we'll need a new root too */
+		if ( in->parent == NULL )
+		{
+			TROT_MALLOC( newIndexNode, 1 );
+			newIndexNode->parent = (*spares);
+			(*spares) = newIndexNode;
+			newIndexNode = NULL;
+		}
+
+		in = in->parent;
+	}
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	indexFreeSpares( program, spares );
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Frees index nodes that were allocated but not used.
+	\param[in] program List that maintains memory limit
+	\param[in] spares Index nodes chained through their parent pointers. Will
+		be NULL after.
+	\return void
+*/
+static void indexFreeSpares( TrotProgram *program, TrotListIndexNode **spares )
+{
+	/* DATA */
+	TrotListIndexNode *in = NULL;
+
+
+	/* CODE */
+	while ( (*spares) != NULL )
+	{
+		in = (*spares);
+		(*spares) = in->parent;
+
+		TROT_FREE( in, 1 );
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Makes the root's only child the new root, for as long as the root
+		only has 1 child.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that owns the index.
+	\return void
+*/
+static void indexShrinkRoot( TrotProgram *program, TrotListActual *la )
+{
+	/* DATA */
+	TrotListIndexNode *in = NULL;
+
+
+	/* CODE */
+	while ( la->indexRoot != NULL && la->indexRoot->used == 1 )
+	{
+		in = la->indexRoot;
+
+		if ( in->level == 1 )
+		{
+			((TrotListNode *)in->children[ 0 ])->parent = NULL;
+			((TrotListNode *)in->children[ 0 ])->slot = 0;
+
+			la->indexRoot = NULL;
+		}
+		else
+		{
+			la->indexRoot = (TrotListIndexNode *)in->children[ 0 ];
+			la->indexRoot->parent = NULL;
+			la->indexRoot->slot = 0;
+		}
+
+		TROT_FREE( in, 1 );
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Grafts laFrom's index onto the end of la's index.
+	\param[in] program List that maintains memory limit
+	\param[in] la List whose index goes on the left.
+	\param[in] laFrom List whose index goes on the right. Must have at least
+		1 node. Its indexRoot will be NULL after.
+	\return TROT_RC
+
+	Call before moving the nodes. The shorter tree becomes a child of the
+	edge of the taller tree, so this is O(log n). On failure nothing is
+	changed.
+*/
+static TROT_RC indexJoin( TrotProgram *program, TrotListActual *la, TrotListActual *laFrom )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	void *top = NULL;
+	TROT_INT height = 0;
+
+	void *topFrom = NULL;
+	TROT_INT heightFrom = 0;
+
+	TrotListIndexNode *in = NULL;
+	TrotListIndexNode *spares = NULL;
+	TrotListIndexNode *newRoot = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( laFrom == NULL );
+	PARANOID_ERR_IF( laFrom->headNode.next == &( laFrom->headNode ) );
+
+
+	/* CODE */
+	/* if la is empty, laFrom's index just moves over */
+	if ( la->headNode.next == &( la->headNode ) )
+	{
+		la->indexRoot = laFrom->indexRoot;
+		laFrom->indexRoot = NULL;
+
+		return TROT_RC_SUCCESS;
+	}
+
+	/* a list with only 1 node has no index, so its node is the top of its
+	   tree */
+	if ( la->indexRoot == NULL )
+	{
+		top = la->headNode.next;
+	}
+	else
+	{
+		top = la->indexRoot;
+		height = la->indexRoot->level;
+	}
+
+	if ( laFrom->indexRoot == NULL )
+	{
+		topFrom = laFrom->headNode.next;
+	}
+	else
+	{
+		topFrom = laFrom->indexRoot;
+		heightFrom = laFrom->indexRoot->level;
+	}
+
+	/* same height, so they both go under a new root */
+	if ( height == heightFrom )
+	{
+		TROT_MALLOC( newRoot, 1 );
+
+		newRoot->level = height + 1;
+		newRoot->used = 2;
+		newRoot->parent = NULL;
+		newRoot->slot = 0;
+
+		indexSetChild( newRoot, 0, top, la->childrenCount );
+		indexSetChild( newRoot, 1, topFrom, laFrom->childrenCount );
+
+		la->indexRoot = newRoot;
+	}
+	/* laFrom's tree becomes the last child of la's rightmost index node
+	   that's one level above it */
+	else if ( height > heightFrom )
+	{
+		in = la->indexRoot;
+		while ( in->level != heightFrom + 1 )
+		{
+			in = (TrotListIndexNode *)in->children[ in->used - 1 ];
+		}
+
+		rc = indexAllocSpares( program, in, &spares );
+		ERR_IF_PASSTHROUGH;
+
+		indexInsert( la, in, in->used, topFrom, 0, &spares );
+
+		if ( heightFrom == 0 )
+		{
+			indexAddCount( ((TrotListNode *)topFrom)->parent, ((TrotListNode *)topFrom)->slot, laFrom->childrenCount );
+		}
+		else
+		{
+			indexAddCount( ((TrotListIndexNode *)topFrom)->parent, ((TrotListIndexNode *)topFrom)->slot, laFrom->childrenCount );
+		}
+	}
+	/* la's tree becomes the first child of laFrom's leftmost index node
+	   that's one level above it */
+	else
+	{
+		in = laFrom->indexRoot;
+		while ( in->level != height + 1 )
+		{
+			in = (TrotListIndexNode *)in->children[ 0 ];
+		}
+
+		rc = indexAllocSpares( program, in, &spares );
+		ERR_IF_PASSTHROUGH;
+
+		la->indexRoot = laFrom->indexRoot;
+
+		indexInsert( la, in, 0, top, 0, &spares );
+
+		if ( height == 0 )
+		{
+			indexAddCount( ((TrotListNode *)top)->parent, ((TrotListNode *)top)->slot, la->childrenCount );
+		}
+		else
+		{
+			indexAddCount( ((TrotListIndexNode *)top)->parent, ((TrotListIndexNode *)top)->slot, la->childrenCount );
+		}
+	}
+
+	PARANOID_ERR_IF( spares != NULL );
+
+	laFrom->indexRoot = NULL;
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Splits la's index after node. The nodes after node go into
+		newLa's index.
+	\param[in] program List that maintains memory limit
+	\param[in] la List that owns the index.
+	\param[in] newLa List to give the right half of the index to. Must not
+		have an index.
+	\param[in] node Last node to keep in la's index. Must not be la's last
+		node.
+	\return TROT_RC
+
+	Call before moving the nodes. Each index node on the path from node to
+	the root is split in 2, so this is O(log n). On failure nothing is
+	changed.
+*/
+static TROT_RC indexSplit( TrotProgram *program, TrotListActual *la, TrotListActual *newLa, TrotListNode *node )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListIndexNode *spares = NULL;
+	TrotListIndexNode *newIn = NULL;
+
+	TrotListIndexNode *in = NULL;
+	TROT_INT slot = 0;
+
+	TrotListIndexNode *right = NULL;
+	TROT_INT leftTotal = 0;
+	TROT_INT rightTotal = 0;
+
+	TROT_INT j = 0;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( la->indexRoot == NULL );
+	PARANOID_ERR_IF( newLa == NULL );
+	PARANOID_ERR_IF( newLa->indexRoot != NULL );
+	PARANOID_ERR_IF( node == NULL );
+	PARANOID_ERR_IF( node->next == &( la->headNode ) );
+
+
+	/* CODE */
+	/* allocate an index node for each level, so we can't fail halfway
+	   through */
+	for ( j = 0; j < la->indexRoot->level; j += 1 )
+	{
+		TROT_MALLOC( newIn, 1 );
+		newIn->parent = spares;
+		spares = newIn;
+		newIn = NULL;
+	}
+
+	/* walk up from node, moving everything to the right of the path into
+	   the new index nodes */
+	leftTotal = node->count;
+
+	in = node->parent;
+	slot = node->slot;
+	while ( in != NULL )
+	{
+		newIn = spares;
+		spares = spares->parent;
+
+		newIn->level = in->level;
+		newIn->used = 0;
+		newIn->parent = NULL;
+		newIn->slot = 0;
+
+		/* right half of the level below comes first */
+		if ( right != NULL )
+		{
+			indexSetChild( newIn, 0, right, rightTotal );
+			newIn->used = 1;
+		}
+
+		/* then everything after the path */
+		for ( j = slot + 1; j < in->used; j += 1 )
+		{
+			indexSetChild( newIn, newIn->used, in->children[ j ], in->counts[ j ] );
+			newIn->used += 1;
+		}
+
+		in->used = slot + 1;
+		in->counts[ slot ] = leftTotal;
+
+		/* *** */
+		leftTotal = 0;
+		for ( j = 0; j < in->used; j += 1 )
+		{
+			leftTotal += in->counts[ j ];
+		}
+
+		rightTotal = 0;
+		for ( j = 0; j < newIn->used; j += 1 )
+		{
+			rightTotal += newIn->counts[ j ];
+		}
+
+		if ( newIn->used == 0 )
+		{
+			TROT_FREE( newIn, 1 );
+			newIn = NULL;
+		}
+
+		right = newIn;
+		newIn = NULL;
+
+		/* up */
+		slot = in->slot;
+		in = in->parent;
+	}
+
+	PARANOID_ERR_IF( spares != NULL );
+	PARANOID_ERR_IF( right == NULL );
+
+	newLa->indexRoot = right;
+
+	indexShrinkRoot( program, la );
+	indexShrinkRoot( program, newLa );
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	indexFreeSpares( program, &spares );
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Frees an index node and everything under it. Doesn't free the
+		list's nodes.
+	\param[in] program List that maintains memory limit
+	\param[in] in Index node to free. Can be NULL, and this will be a noop.
+	\return void
+*/
+static void indexFree( TrotProgram *program, TrotListIndexNode *in )
+{
+	/* DATA */
+	TROT_INT i = 0;
+
+
+	/* CODE */
+	if ( in == NULL )
+	{
+		return;
+	}
+
+	if ( in->level > 1 )
+	{
+		for ( i = 0; i < in->used; i += 1 )
+		{
+			indexFree( program, (TrotListIndexNode *)in->children[ i ] );
+		}
+	}
+
+	TROT_FREE( in, 1 );
+
+	return;
+}
+
+/******************************************************************************/
+static void refListAdd( TrotProgram *program, TrotListActual *la, TrotList *l )
+{
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( l->laPointsTo != la );
+
+
+	/* CODE */
+	refLink( la, l );
+
+	/* a list that just got a ref isn't garbage */
+	if ( program->gcMode == TROT_GC_CYCLES )
+	{
+		la->flagVisited = GC_COLOR_BLACK;
+	}
+
+	/* a new ref can move a list the collector hasn't marked to somewhere
+	   it's already looked */
+	gcShade( program, la );
+
+	return;
+}
+
+/******************************************************************************/
+static void refListRemove( TrotProgram *program, TrotListActual *la, TrotList *l )
+{
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( l->laPointsTo != la );
+
+
+	/* CODE */
+	(void)program;
+
+	refUnlink( la, l );
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Links a ref into its list's refList. Client refs go at the front,
+		and refs that are in a list go at the back.
+	\param[in] la List l points to.
+	\param[in] l Ref to link in.
+	\return void
+*/
+static void refLink( TrotListActual *la, TrotList *l )
+{
+	/* DATA */
+	TrotList *first = la->refList;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( l == NULL );
+
+
+	/* CODE */
+	if ( first == NULL )
+	{
+		l->refPrev = l;
+		l->refNext = NULL;
+		la->refList = l;
+	}
+	else if ( l->laParent == NULL )
+	{
+		l->refPrev = first->refPrev;
+		l->refNext = first;
+		first->refPrev = l;
+		la->refList = l;
+	}
+	else
+	{
+		l->refPrev = first->refPrev;
+		l->refNext = NULL;
+		first->refPrev->refNext = l;
+		first->refPrev = l;
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Takes a ref out of its list's refList.
+	\param[in] la List l points to.
+	\param[in] l Ref to take out.
+	\return void
+*/
+static void refUnlink( TrotListActual *la, TrotList *l )
+{
+	/* PRECOND */
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( la->refList == NULL );
+	PARANOID_ERR_IF( l->refPrev == NULL );
+
+
+	/* CODE */
+	if ( l == la->refList )
+	{
+		la->refList = l->refNext;
+	}
+	else
+	{
+		l->refPrev->refNext = l->refNext;
+	}
+
+	if ( l->refNext != NULL )
+	{
+		l->refNext->refPrev = l->refPrev;
+	}
+	else if ( la->refList != NULL )
+	{
+		/* l was the last ref */
+		la->refList->refPrev = l->refPrev;
+	}
+
+	l->refPrev = NULL;
+	l->refNext = NULL;
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Checks if a list has a client ref, a ref that isn't in a list.
+	\param[in] la The list.
+	\return 1 if it does, else 0.
+
+	Client refs are at the front of refList, so only the first ref has to be
+	looked at.
+*/
+static TROT_INT refListHasClient( TrotListActual *la )
+{
+	return la->refList != NULL && la->refList->laParent == NULL;
 }
 
 /******************************************************************************/
 /*!
-	\brief Sets the tag of a list.
+	\brief Frees a ref that has already been taken out of its list's refList.
 	\param[in] program List that maintains memory limit
-	\param[in] l The list.
-	\param[in] tag The tag value to set.
-	\return TROT_RC
+	\param[in] l The ref.
+	\return void
+
+	The first ref to a list is part of the list's TrotListActual, so it's
+	left alone here and goes away when the list is freed.
 */
-TROT_RC trotListSetTag( TrotProgram *program, TrotList *l, TROT_INT tag )
+static void refFree( TrotProgram *program, TrotList *l )
 {
 	/* PRECOND */
-	FAILURE_POINT;
 	PARANOID_ERR_IF( program == NULL );
 	PARANOID_ERR_IF( l == NULL );
 
 
 	/* CODE */
-	(void)program;
-
-	l->laPointsTo->tag = tag;
+	if ( l != &( l->laPointsTo->firstRef ) )
+	{
+		TROT_FREE( l, 1 );
+	}
 
-	return TROT_RC_SUCCESS;
+	return;
 }
 
 /******************************************************************************/
 /*!
-	\brief Splits a node, leaving keepInLeft into the left/prev node, and
-		moving the rest into the new right/next node.
-	\param[in] program List that maintains memory limit
-	\param[in] n Node to split.
-	\param[in] keepInLeft How many items to keep in n.
-	\return TROT_RC
+	\brief Sets which list a ref is in, keeping client refs at the front of
+		the refList of the list it points to.
+	\param[in] l Ref.
+	\param[in] laParent List l is now in, or NULL if it's now a client ref.
+	\return void
 */
-static TROT_RC trotListNodeSplit( TrotProgram *program, TrotListNode *n, TROT_INT keepInLeft )
+static void refSetParent( TrotList *l, TrotListActual *laParent )
 {
-	/* DATA */
-	TROT_RC rc = TROT_RC_SUCCESS;
-
-	TrotListNode *newNode = NULL;
-
-	TROT_INT i = 0;
-
-
 	/* PRECOND */
-	PARANOID_ERR_IF( program == NULL );
-	PARANOID_ERR_IF( n == NULL );
+	PARANOID_ERR_IF( l == NULL );
 
 
 	/* CODE */
-	TROT_MALLOC( newNode, 1 );
-
-	if ( n->n != NULL )
+	if ( ( l->laParent == NULL ) != ( laParent == NULL ) )
 	{
-		newNode->count = (n->count) - keepInLeft;
-
-		newNode->l = NULL;
-		TROT_MALLOC( newNode->n, TROT_NODE_SIZE );
-
-		i = keepInLeft;
-		while ( i < (n->count) )
-		{
-			newNode->n[ i - keepInLeft ] = n->n[ i ];
-
-			i += 1;
-		}
-
-		n->count = keepInLeft;
+		refUnlink( l->laPointsTo, l );
+		l->laParent = laParent;
+		refLink( l->laPointsTo, l );
 	}
-	else /* n is list kind */
+	else
 	{
-		newNode->count = (n->count) - keepInLeft;
-
-		newNode->n = NULL;
-		TROT_CALLOC( newNode->l, TROT_NODE_SIZE );
-
-		i = keepInLeft;
-		while ( i < (n->count) )
-		{
-			newNode->l[ i - keepInLeft ] = n->l[ i ];
-			n->l[ i ] = NULL;
-
-			i += 1;
-		}
-
-		n->count = keepInLeft;
+		l->laParent = laParent;
 	}
 
-	newNode->prev = n;
-	newNode->next = n->next;
-
-	n->next->prev = newNode;
-	n->next = newNode;
-
-	return TROT_RC_SUCCESS;
-
-
-	/* CLEANUP */
-	cleanup:
-
-	TROT_FREE( newNode, 1 );
-
-	return rc;
+	return;
 }
 
 /******************************************************************************/
 /*!
-	\brief Creates a new TrotListNode for Int.
-	\param[in] program List that maintains memory limit
-	\param[in] insertBeforeThis Node in list to insert before
-	\param[in] n Int to insert into new node.
-	\return TROT_RC
+	\brief Marks a list while the collector is marking, so it and what it
+		holds survive this collection.
+	\param[in] program Program la is in.
+	\param[in] la List to mark.
+	\return void
 */
-static TROT_RC newIntNode( TrotProgram *program, TrotListNode *insertBeforeThis, TROT_INT n )
+static void gcShade( TrotProgram *program, TrotListActual *la )
 {
-	/* DATA */
-	TROT_RC rc = TROT_RC_SUCCESS;
-
-	TrotListNode *newNode = NULL;
-
-
 	/* PRECOND */
 	PARANOID_ERR_IF( program == NULL );
-	PARANOID_ERR_IF( insertBeforeThis == NULL );
+	PARANOID_ERR_IF( la == NULL );
 
 
 	/* CODE */
-	TROT_MALLOC( newNode, 1 );
-
-	newNode->l = NULL;
-	TROT_MALLOC( newNode->n, TROT_NODE_SIZE );
-
-	newNode->count = 1;
-
-	newNode->n[ 0 ] = n;
-
-	/* insert node in list */
-	newNode->next = insertBeforeThis;
-	newNode->prev = insertBeforeThis->prev;
-
-	insertBeforeThis->prev->next = newNode;
-	insertBeforeThis->prev = newNode;
-
-	return TROT_RC_SUCCESS;
-
+	if (    program->gcPhase != GC_PHASE_ROOTS
+	     && program->gcPhase != GC_PHASE_MARK
+	   )
+	{
+		return;
+	}
 
-	/* CLEANUP */
-	cleanup:
+	if ( la->flagVisited == program->gcEpoch )
+	{
+		return;
+	}
 
-	TROT_FREE( newNode, 1 );
+	la->flagVisited = program->gcEpoch;
+	la->link.nextToFree = program->gcStack;
+	program->gcStack = la;
 
-	return rc;
+	return;
 }
 
 /******************************************************************************/
 /*!
-	\brief Creates a new TrotListNode for List.
-	\param[in] program List that maintains memory limit
-	\param[in] insertBeforeThis Node in list to insert before
-	\param[in] l List to twin and insert into new node
-	\return TROT_RC
+	\brief Marks every list a list holds.
+	\param[in] program Program la is in.
+	\param[in] la List to scan.
+	\return How much work it was.
 */
-static TROT_RC newListNode( TrotProgram *program, TrotListActual *la, TrotListNode *insertBeforeThis, TrotList *l )
+static TROT_INT gcScan( TrotProgram *program, TrotListActual *la )
 {
 	/* DATA */
-	TROT_RC rc = TROT_RC_SUCCESS;
+	TROT_INT work = 1;
 
-	TrotListNode *newNode = NULL;
+	TrotListNode *node = NULL;
 
-	TrotList *newL = NULL;
+	TROT_INT j = 0;
+	TrotList *ref = NULL;
 
 
 	/* PRECOND */
 	PARANOID_ERR_IF( program == NULL );
 	PARANOID_ERR_IF( la == NULL );
-	PARANOID_ERR_IF( insertBeforeThis == NULL );
-	PARANOID_ERR_IF( l == NULL );
 
 
 	/* CODE */
-	rc = trotListTwin( program, l, &newL );
-	ERR_IF_PASSTHROUGH;
-
-	TROT_MALLOC( newNode, 1 );
-
-	newNode->n = NULL;
-	TROT_CALLOC( newNode->l, TROT_NODE_SIZE );
-
-	newNode->count = 1;
-
-	newNode->l[ 0 ] = newL;
-	newL->laParent = la;
-	newL = NULL;
-
-	/* insert node in list */
-	newNode->next = insertBeforeThis;
-	newNode->prev = insertBeforeThis->prev;
-
-	insertBeforeThis->prev->next = newNode;
-	insertBeforeThis->prev = newNode;
-
-	return TROT_RC_SUCCESS;
-
+	node = la->headNode.next;
+	while ( node != &( la->headNode ) )
+	{
+		if ( node->kind != NODE_KIND_INT )
+		{
+			for ( j = 0; j < node->count; j += 1 )
+			{
+				ref = nodeListAt( node, j );
+				if ( ref != NULL )
+				{
+					gcShade( program, ref->laPointsTo );
+				}
+			}
 
-	/* CLEANUP */
-	cleanup:
+			work += node->count;
+		}
 
-	trotListFree( program, &newL );
-	TROT_FREE( newNode, 1 );
+		node = node->next;
+	}
 
-	return rc;
+	return work;
 }
 
 /******************************************************************************/
-static TROT_RC refListAdd( TrotProgram *program, TrotListActual *la, TrotList *l )
+/*!
+	\brief Frees the data of a list the collector found to be garbage.
+	\param[in] program Program la is in.
+	\param[in] la List whose data to free.
+	\return How much work it was.
+*/
+static TROT_INT gcFreeData( TrotProgram *program, TrotListActual *la )
 {
 	/* DATA */
-	TROT_RC rc = TROT_RC_SUCCESS;
+	TROT_INT work = 1;
+
+	TrotListNode *node = NULL;
+	TrotListNode *nextNode = NULL;
 
-	TrotListRefListNode *newRefNode = NULL;
+	TROT_INT j = 0;
+	TrotList *ref = NULL;
 
 
 	/* PRECOND */
 	PARANOID_ERR_IF( program == NULL );
 	PARANOID_ERR_IF( la == NULL );
-	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( la->reachable );
 
 
 	/* CODE */
-	TROT_MALLOC( newRefNode, 1 );
+	node = la->headNode.next;
+	while ( node != &( la->headNode ) )
+	{
+		if ( node->kind != NODE_KIND_INT )
+		{
+			for ( j = 0; j < node->count; j += 1 )
+			{
+				ref = nodeListAt( node, j );
+				if ( ref == NULL )
+				{
+					continue;
+				}
 
-	newRefNode->l = l;
+				/* garbage lists don't need their refList kept up to
+				   date, they're about to be freed */
+				if ( ref->laPointsTo->reachable )
+				{
+					refListRemove( program, ref->laPointsTo, ref );
+				}
 
-	newRefNode->next = la->refList;
-	la->refList = newRefNode;
+				refFree( program, ref );
+			}
 
+			work += node->count;
+		}
 
-	/* CLEANUP */
-	cleanup:
+		nextNode = node->next;
+		nodeFree( program, la, node );
+		node = nextNode;
+	}
 
-	return rc;
+	return work;
 }
 
 /******************************************************************************/
-static void refListRemove( TrotProgram *program, TrotListActual *la, TrotList *l )
+/*!
+	\brief Frees a list the collector found to be garbage, after its data has
+		been freed.
+	\param[in] program Program la is in.
+	\param[in] la List to free.
+	\return void
+*/
+static void gcFreeList( TrotProgram *program, TrotListActual *la )
 {
-	/* DATA */
-	TrotListRefListNode *refPrev = NULL;
-	TrotListRefListNode *refNode = NULL;
-
-
 	/* PRECOND */
 	PARANOID_ERR_IF( program == NULL );
 	PARANOID_ERR_IF( la == NULL );
-	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( la->reachable );
 
 
 	/* CODE */
-	refNode = la->refList;
-
-	/* edge case */
-	if ( refNode->l == l )
-	{
-		la->refList = refNode->next;
-		TROT_FREE( refNode, 1 );
-
-		return;
-	}
-
-	/* foreach refNode */
-	while ( 1 )
-	{
-		refPrev = refNode;
-		refNode = refNode->next;
-
-		if ( refNode->l == l )
-		{
-			refPrev->next = refNode->next;
-			TROT_FREE( refNode, 1 );
-
-			return;
-		}
-
-		PARANOID_ERR_IF( refNode->next == NULL );
-	}
+	/* refs that still point to la were in other garbage lists, and were
+	   freed with their data */
+	indexFree( program, la->indexRoot );
+	TROT_FREE( la, 1 );
 
 	return;
 }
@@ -2083,7 +6888,20 @@ static void isListReachable( TrotListActual *la )
 
 
 	/* CODE */
-	/* go "up" trying to find a client ref */
+	/* most of the time we don't have to search. a list with a client ref is
+	   reachable, and a list with no refs isn't */
+	if ( refListHasClient( la ) )
+	{
+		return;
+	}
+
+	if ( la->refList == NULL )
+	{
+		la->reachable = 0;
+		return;
+	}
+
+	/* go "up" trying to find a parent with a client ref */
 	currentLa = la;
 	currentLa->flagVisited = 1;
 
@@ -2091,11 +6909,11 @@ static void isListReachable( TrotListActual *la )
 	{
 		if ( findNextParent( currentLa, 0, &parent ) != 0 )
 		{
-			if ( currentLa->previous != NULL )
+			if ( currentLa->link.previous != NULL )
 			{
 				tempLa = currentLa;
-				currentLa = currentLa->previous;
-				tempLa->previous = NULL;
+				currentLa = currentLa->link.previous;
+				tempLa->link.previous = NULL;
 
 				continue;
 			}
@@ -2104,13 +6922,13 @@ static void isListReachable( TrotListActual *la )
 		}
 
 		/* did we find a client ref? */
-		if ( parent == NULL )
+		if ( refListHasClient( parent ) )
 		{
 			flagFoundClientRef = 1;
 			break;
 		}
 
-		parent->previous = currentLa;
+		parent->link.previous = currentLa;
 		currentLa = parent;
 		currentLa->flagVisited = 1;
 	}
@@ -2128,11 +6946,11 @@ static void isListReachable( TrotListActual *la )
 	{
 		if ( findNextParent( currentLa, 1, &parent ) != 0 )
 		{
-			if ( currentLa->previous != NULL )
+			if ( currentLa->link.previous != NULL )
 			{
 				tempLa = currentLa;
-				currentLa = currentLa->previous;
-				tempLa->previous = NULL;
+				currentLa = currentLa->link.previous;
+				tempLa->link.previous = NULL;
 
 				continue;
 			}
@@ -2140,7 +6958,7 @@ static void isListReachable( TrotListActual *la )
 			break;
 		}
 
-		parent->previous = currentLa;
+		parent->link.previous = currentLa;
 		currentLa = parent;
 		currentLa->flagVisited = 0;
 	}
@@ -2152,7 +6970,7 @@ static void isListReachable( TrotListActual *la )
 static TROT_INT findNextParent( TrotListActual *la, TROT_INT queryVisited, TrotListActual **parent )
 {
 	/* DATA */
-	TrotListRefListNode *refNode = NULL;
+	TrotList *ref = NULL;
 
 	TrotListActual *tempParent = NULL;
 
@@ -2164,37 +6982,133 @@ static TROT_INT findNextParent( TrotListActual *la, TROT_INT queryVisited, TrotL
 
 	/* CODE */
 	/* for each reference that points to this list */
-	refNode = la->refList;
-	while ( refNode != NULL )
+	ref = la->refList;
+	while ( ref != NULL )
 	{
 		/* get list this ref is in */
-		tempParent = refNode->l->laParent;
+		tempParent = ref->laParent;
 
 		/* if ref has no parent, it means it's a client
-		   reference, and so the list is reachable, but we only
-		   care if our caller is looking for not visited
-		   parents */
+		   reference. isListReachable checks for client refs
+		   before it gets here, so we skip these */
 		if ( tempParent == NULL )
 		{
-			if ( queryVisited == 0 )
-			{
-				(*parent) = NULL;
-				return 0;
-			}
+			/* skip */
 		}
-		/* if this matches our 'visit' query, then return it */
-		else if ( tempParent->flagVisited == queryVisited )
+		/* if this matches our 'visit' query, then return it. parents
+		   that aren't reachable are waiting to be freed, so they can't
+		   make us reachable, and their link is used for nextToFree */
+		else if ( tempParent->reachable == 1 && tempParent->flagVisited == queryVisited )
 		{
 			(*parent) = tempParent;
 			return 0;
 		}
 
-		refNode = refNode->next;
+		ref = ref->refNext;
 	}
 
 	return -1;
 }
 
+/******************************************************************************/
+/*!
+	\brief Sees whether a list that just lost a ref still has any, when the
+		program's gcMode is TROT_GC_CYCLES.
+	\param[in] program Program la is in.
+	\param[in] la List to check.
+	\return void
+
+	A list with no refs isn't reachable. A list that only has refs from other
+	lists might be part of a garbage cycle, so it goes in gcRoots for
+	trotListCollectCycles to look at.
+*/
+static void isListReferenced( TrotProgram *program, TrotListActual *la )
+{
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+	PARANOID_ERR_IF( la->reachable == 0 );
+
+
+	/* CODE */
+	if ( la->refList == NULL )
+	{
+		la->reachable = 0;
+		return;
+	}
+
+	if ( ! refListHasClient( la ) )
+	{
+		gcPossibleRoot( program, la );
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Puts a list in the program's gcRoots, if it isn't already there.
+	\param[in] program Program la is in.
+	\param[in] la List that might be part of a garbage cycle.
+	\return void
+*/
+static void gcPossibleRoot( TrotProgram *program, TrotListActual *la )
+{
+	/* PRECOND */
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( la == NULL );
+
+
+	/* CODE */
+	la->flagVisited = GC_COLOR_PURPLE;
+
+	if ( la->flagBuffered == 0 )
+	{
+		la->flagBuffered = 1;
+		la->heapNext = program->gcRoots;
+		program->gcRoots = la;
+		program->gcRootsCount += 1;
+	}
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Checks if a gray list has a ref that isn't in a gray list.
+	\param[in] la The list.
+	\return 1 if it does, else 0.
+
+	A ref in a list that has already been marked black counts as outside
+	too. That's fine, since everything that list holds is black by then.
+*/
+static TROT_INT gcHeldFromOutside( TrotListActual *la )
+{
+	/* DATA */
+	TrotList *ref = NULL;
+
+
+	/* PRECOND */
+	PARANOID_ERR_IF( la == NULL );
+
+
+	/* CODE */
+	ref = la->refList;
+	while ( ref != NULL )
+	{
+		if (    ref->laParent == NULL
+		     || ref->laParent->flagVisited != GC_COLOR_GRAY
+		   )
+		{
+			return 1;
+		}
+
+		ref = ref->refNext;
+	}
+
+	return 0;
+}
+
 /******************************************************************************/
 /*!
 	\brief Provides a const char string representation for a TROT_RC
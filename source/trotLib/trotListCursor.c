@@ -0,0 +1,535 @@
+/*
+Copyright (c) 2010-2014 Jeremiah Martell
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    - Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    - Neither the name of Jeremiah Martell nor the name of GeekHorse nor the
+      name of Trot nor the names of its contributors may be used to endorse or
+      promote products derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/******************************************************************************/
+/*!
+	\file
+	Cursor for walking through a list one item at a time.
+
+	Walking a list with an increasing index has to find each index from the
+	top of the list. A cursor remembers the node and offset of the current
+	item, so moving to the next or previous item is O(1).
+*/
+#undef  TROT_FILE_NUMBER
+#define TROT_FILE_NUMBER 2
+
+/******************************************************************************/
+#include "trot.h"
+#include "trotInternal.h"
+
+/******************************************************************************/
+/*!
+	\brief Sets up a cursor before the first item of a list.
+	\param[in] program List that maintains memory limit
+	\param[in] l The list to walk through.
+	\param[out] c The cursor.
+	\return TROT_RC
+
+	The cursor doesn't hold a reference of its own, so l must stay alive while
+	the cursor is used.
+*/
+TROT_RC trotListCursorInit( TrotProgram *program, TrotList *l, TrotListCursor *c )
+{
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( l == NULL );
+	PARANOID_ERR_IF( c == NULL );
+
+
+	/* CODE */
+	(void)program;
+
+	c->l = l;
+	c->node = NULL;
+	c->i = 0;
+	c->index = 0;
+
+	return TROT_RC_SUCCESS;
+}
+
+/******************************************************************************/
+/*!
+	\brief Moves a cursor to the next item.
+	\param[in] program List that maintains memory limit
+	\param[in] c The cursor.
+	\return TROT_RC
+
+	Moving past the last item puts the cursor after the last item. Moving
+	again from there is an error.
+*/
+TROT_RC trotListCursorNext( TrotProgram *program, TrotListCursor *c )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( c == NULL );
+
+
+	/* CODE */
+	(void)program;
+
+	la = c->l->laPointsTo;
+
+	ERR_IF_1( c->index > la->childrenCount, TROT_RC_ERROR_BAD_INDEX, c->index );
+
+	c->index += 1;
+
+	/* before first item? */
+	if ( c->node == NULL )
+	{
+		if ( c->index <= la->childrenCount )
+		{
+			c->node = la->headNode.next;
+			c->i = 0;
+		}
+
+		return TROT_RC_SUCCESS;
+	}
+
+	/* *** */
+	c->i += 1;
+	if ( c->i == c->node->count )
+	{
+		c->node = c->node->next;
+		c->i = 0;
+
+		if ( c->node == &( la->headNode ) )
+		{
+			c->node = NULL;
+		}
+	}
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Moves a cursor to the previous item.
+	\param[in] program List that maintains memory limit
+	\param[in] c The cursor.
+	\return TROT_RC
+
+	Moving past the first item puts the cursor before the first item. Moving
+	again from there is an error.
+*/
+TROT_RC trotListCursorPrev( TrotProgram *program, TrotListCursor *c )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( c == NULL );
+
+
+	/* CODE */
+	(void)program;
+
+	la = c->l->laPointsTo;
+
+	ERR_IF_1( c->index < 1, TROT_RC_ERROR_BAD_INDEX, c->index );
+
+	c->index -= 1;
+
+	/* after last item? */
+	if ( c->node == NULL )
+	{
+		if ( c->index >= 1 )
+		{
+			c->node = la->last;
+			c->i = c->node->count - 1;
+		}
+
+		return TROT_RC_SUCCESS;
+	}
+
+	/* *** */
+	c->i -= 1;
+	if ( c->i < 0 )
+	{
+		c->node = trotListNodePrev( la, c->node );
+		c->i = c->node->count - 1;
+
+		if ( c->node == &( la->headNode ) )
+		{
+			c->node = NULL;
+			c->i = 0;
+		}
+	}
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Moves a cursor to an index.
+	\param[in] program List that maintains memory limit
+	\param[in] c The cursor.
+	\param[in] index Where to move to.
+	\return TROT_RC
+
+	index can be 0 to move before the first item, or count + 1 to move after
+	the last item. Negative indices count back from the end like they do for
+	trotListGetInt.
+*/
+TROT_RC trotListCursorSeek( TrotProgram *program, TrotListCursor *c, TROT_INT index )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+
+	TROT_INT count = 0;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( c == NULL );
+
+
+	/* CODE */
+	(void)program;
+
+	la = c->l->laPointsTo;
+
+	/* Turn negative index into positive equivalent. */
+	if ( index < 0 )
+	{
+		index = (la->childrenCount) + index + 1;
+	}
+
+	/* Make sure index is in range */
+	ERR_IF_1( index < 0, TROT_RC_ERROR_BAD_INDEX, index );
+	ERR_IF_1( index > (la->childrenCount) + 1, TROT_RC_ERROR_BAD_INDEX, index );
+
+	/* *** */
+	c->index = index;
+	c->node = NULL;
+	c->i = 0;
+
+	if ( index >= 1 && index <= la->childrenCount )
+	{
+		trotListFindNode( la, index, &(c->node), &count );
+		c->i = index - count - 1;
+	}
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets the kind of the item at a cursor.
+	\param[in] program List that maintains memory limit
+	\param[in] c The cursor.
+	\param[out] kind On success, will contain the kind of the item.
+	\return TROT_RC
+*/
+TROT_RC trotListCursorGetKind( TrotProgram *program, TrotListCursor *c, TROT_INT *kind )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( c == NULL );
+	PARANOID_ERR_IF( kind == NULL );
+
+
+	/* CODE */
+	(void)program;
+
+	ERR_IF_1( c->node == NULL, TROT_RC_ERROR_BAD_INDEX, c->index );
+
+	(*kind) = trotListNodeGetKind( c->node, c->i );
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets the int at a cursor.
+	\param[in] program List that maintains memory limit
+	\param[in] c The cursor.
+	\param[out] n On success, the int at the cursor.
+	\return TROT_RC
+*/
+TROT_RC trotListCursorGetInt( TrotProgram *program, TrotListCursor *c, TROT_INT *n )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( c == NULL );
+	PARANOID_ERR_IF( n == NULL );
+
+
+	/* CODE */
+	(void)program;
+
+	ERR_IF_1( c->node == NULL, TROT_RC_ERROR_BAD_INDEX, c->index );
+	ERR_IF( trotListNodeGetKind( c->node, c->i ) != NODE_KIND_INT, TROT_RC_ERROR_WRONG_KIND );
+
+	/* give back */
+	if ( c->node->kind == NODE_KIND_INT )
+	{
+		(*n) = NODE_GET_INT( c->node, c->i );
+	}
+	else
+	{
+		(*n) = NODE_SLOTS( c->node )[ c->i ].u.n;
+	}
+
+	return TROT_RC_SUCCESS;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Gets the list at a cursor.
+	\param[in] program List that maintains memory limit
+	\param[in] c The cursor.
+	\param[out] lTwin_A On success, a new reference to the list at the
+		cursor.
+	\return TROT_RC
+*/
+TROT_RC trotListCursorGetList( TrotProgram *program, TrotListCursor *c, TrotList **lTwin_A )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( c == NULL );
+	PARANOID_ERR_IF( lTwin_A == NULL );
+	PARANOID_ERR_IF( (*lTwin_A) != NULL );
+
+
+	/* CODE */
+	ERR_IF_1( c->node == NULL, TROT_RC_ERROR_BAD_INDEX, c->index );
+	ERR_IF( trotListNodeGetKind( c->node, c->i ) != NODE_KIND_LIST, TROT_RC_ERROR_WRONG_KIND );
+
+	if ( c->node->kind == NODE_KIND_LIST )
+	{
+		rc = trotListTwin( program, NODE_LISTS( c->node )[ c->i ], lTwin_A );
+	}
+	else
+	{
+		rc = trotListTwin( program, NODE_SLOTS( c->node )[ c->i ].u.l, lTwin_A );
+	}
+	ERR_IF_PASSTHROUGH;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Inserts an int at a cursor.
+	\param[in] program List that maintains memory limit
+	\param[in] c The cursor.
+	\param[in] n The int to insert.
+	\return TROT_RC
+
+	The int is inserted before the item at the cursor, or appended if the
+	cursor is after the last item. On success, the cursor will be at the new
+	int.
+*/
+TROT_RC trotListCursorInsertInt( TrotProgram *program, TrotListCursor *c, TROT_INT n )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TROT_INT index = 0;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( c == NULL );
+
+
+	/* CODE */
+	index = c->index;
+	if ( index == 0 )
+	{
+		index = 1;
+	}
+
+	rc = trotListInsertInt( program, c->l, index, n );
+	ERR_IF_PASSTHROUGH;
+
+	/* the list has changed, so find our node again */
+	rc = trotListCursorSeek( program, c, index );
+	PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Inserts a list at a cursor.
+	\param[in] program List that maintains memory limit
+	\param[in] c The cursor.
+	\param[in] lToInsert The list to insert.
+	\return TROT_RC
+
+	The list is inserted before the item at the cursor, or appended if the
+	cursor is after the last item. On success, the cursor will be at the new
+	list.
+*/
+TROT_RC trotListCursorInsertList( TrotProgram *program, TrotListCursor *c, TrotList *lToInsert )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TROT_INT index = 0;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( c == NULL );
+	PARANOID_ERR_IF( lToInsert == NULL );
+
+
+	/* CODE */
+	index = c->index;
+	if ( index == 0 )
+	{
+		index = 1;
+	}
+
+	rc = trotListInsertList( program, c->l, index, lToInsert );
+	ERR_IF_PASSTHROUGH;
+
+	/* the list has changed, so find our node again */
+	rc = trotListCursorSeek( program, c, index );
+	PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Removes the item at a cursor.
+	\param[in] program List that maintains memory limit
+	\param[in] c The cursor.
+	\return TROT_RC
+
+	On success, the cursor will be at the item that followed the removed
+	item, or after the last item.
+*/
+TROT_RC trotListCursorRemove( TrotProgram *program, TrotListCursor *c )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+
+	/* PRECOND */
+	FAILURE_POINT;
+	PARANOID_ERR_IF( program == NULL );
+	PARANOID_ERR_IF( c == NULL );
+
+
+	/* CODE */
+	ERR_IF_1( c->node == NULL, TROT_RC_ERROR_BAD_INDEX, c->index );
+
+	rc = trotListRemove( program, c->l, c->index );
+	ERR_IF_PASSTHROUGH;
+
+	/* the list has changed, so find our node again */
+	rc = trotListCursorSeek( program, c, c->index );
+	PARANOID_ERR_IF( rc != TROT_RC_SUCCESS );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
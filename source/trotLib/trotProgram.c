@@ -39,27 +39,93 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "trot.h"
 #include "trotInternal.h"
 
+/******************************************************************************/
+#define SLAB_CLASS( size ) ( (TROT_INT)( ( (size) - 1 ) / TROT_SLAB_GRAIN ) )
+
+/* a program uses the TROT_HOOK functions unless it was given an allocator */
+#define PROGRAM_MALLOC( program, size ) \
+	( (program)->allocator.mallocFunc == NULL \
+	  ? TROT_HOOK_MALLOC( size ) \
+	  : (program)->allocator.mallocFunc( (program)->allocator.context, size ) )
+
+#define PROGRAM_CALLOC( program, size ) \
+	( (program)->allocator.callocFunc == NULL \
+	  ? TROT_HOOK_CALLOC( 1, size ) \
+	  : (program)->allocator.callocFunc( (program)->allocator.context, 1, size ) )
+
+#define PROGRAM_REALLOC( program, p, size ) \
+	( (program)->allocator.reallocFunc == NULL \
+	  ? TROT_HOOK_REALLOC( p, size ) \
+	  : (program)->allocator.reallocFunc( (program)->allocator.context, p, size ) )
+
+#define PROGRAM_FREE( program, p ) \
+	if ( (program)->allocator.freeFunc == NULL ) \
+	{ \
+		TROT_HOOK_FREE( p ); \
+	} \
+	else \
+	{ \
+		(program)->allocator.freeFunc( (program)->allocator.context, p ); \
+	}
+
+/******************************************************************************/
+static int slabRefill( TrotProgram *program, TROT_INT slabClass );
+static void *bigBlockMalloc( TrotProgram *program, size_t size, int zero );
+
 /******************************************************************************/
 /*!
-	\brief 
-	\param 
+	\brief Creates a program.
+	\param[in] memoryLimit Memory limit of the program.
+	\param[in] allocator Allocator for the program to get all of its memory
+		from, including the program itself. NULL to use the default.
+	\param[in] savedProgram Program to load.
+	\param[out] program_A New program.
 	\return TROT_RC
 */
-TROT_RC trotProgramLoad( TROT_INT memoryLimit, const char *savedProgram, TrotProgram **program_A )
+TROT_RC trotProgramLoad( TROT_INT memoryLimit, const TrotAllocator *allocator, const char *savedProgram, TrotProgram **program_A )
 {
 	/* DATA */
 	TROT_RC rc = TROT_RC_SUCCESS;
 
+	TrotProgram *newProgram = NULL;
+
 
 	/* PRECOND */
 	ERR_IF( memoryLimit <= 0, TROT_RC_ERROR_PRECOND );
+	ERR_IF( allocator != NULL && allocator->mallocFunc == NULL, TROT_RC_ERROR_PRECOND );
+	ERR_IF( allocator != NULL && allocator->callocFunc == NULL, TROT_RC_ERROR_PRECOND );
+	ERR_IF( allocator != NULL && allocator->reallocFunc == NULL, TROT_RC_ERROR_PRECOND );
+	ERR_IF( allocator != NULL && allocator->freeFunc == NULL, TROT_RC_ERROR_PRECOND );
 	ERR_IF( savedProgram == NULL, TROT_RC_ERROR_PRECOND );
 	ERR_IF( program_A == NULL, TROT_RC_ERROR_PRECOND );
 	ERR_IF( (*program_A) != NULL, TROT_RC_ERROR_PRECOND );
 
 
 	/* CODE */
-	/* TODO */
+	if ( allocator == NULL )
+	{
+		newProgram = TROT_HOOK_CALLOC( 1, sizeof( TrotProgram ) );
+	}
+	else
+	{
+		newProgram = allocator->callocFunc( allocator->context, 1, sizeof( TrotProgram ) );
+	}
+
+	ERR_IF( newProgram == NULL, TROT_RC_ERROR_MEMORY_ALLOCATION_FAILED );
+
+	if ( allocator != NULL )
+	{
+		newProgram->allocator = (*allocator);
+	}
+
+	newProgram->memoryLimit = memoryLimit;
+	newProgram->gcBudget = TROT_GC_BUDGET;
+	newProgram->gcEpoch = 1;
+
+	/* TODO: load savedProgram */
+
+	/* give back */
+	(*program_A) = newProgram;
 
 
 	/* CLEANUP */
@@ -149,6 +215,215 @@ TROT_RC trotProgramMemorySetLimit( TrotProgram *program, TROT_INT limit )
 	return rc;
 }
 
+/******************************************************************************/
+/*!
+	\brief Gets how much memory the program's slabs are holding.
+		trotProgramMemoryGetUsed only counts memory that's in use, so bytes
+		minus that is roughly what the slabs are keeping for reuse.
+	\param[in] program Program.
+	\param[out] slabs How many slabs the program has.
+	\param[out] bytes How many bytes the slabs take up.
+	\param[out] objects How many objects in the slabs are in use.
+	\return TROT_RC
+*/
+TROT_RC trotProgramMemoryGetSlabStats( TrotProgram *program, TROT_INT *slabs, TROT_INT *bytes, TROT_INT *objects )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+
+	/* PRECOND */
+	ERR_IF( program == NULL, TROT_RC_ERROR_PRECOND );
+	ERR_IF( slabs == NULL, TROT_RC_ERROR_PRECOND );
+	ERR_IF( bytes == NULL, TROT_RC_ERROR_PRECOND );
+	ERR_IF( objects == NULL, TROT_RC_ERROR_PRECOND );
+
+
+	/* CODE */
+	(*slabs) = program->slabCount;
+	(*bytes) = program->slabBytes;
+	(*objects) = program->slabObjects;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Sets when the program frees lists.
+	\param[in] program Program.
+	\param[in] mode TROT_GC_IMMEDIATE, TROT_GC_DEFERRED or TROT_GC_CYCLES. A
+		program can only start deferring while it's using no memory, since
+		lists it already has wouldn't be found by the collector. Leaving
+		TROT_GC_DEFERRED finishes any collection under way and collects
+		again. Leaving TROT_GC_CYCLES frees any garbage cycles.
+	\return TROT_RC
+*/
+TROT_RC trotProgramGcSetMode( TrotProgram *program, TROT_INT mode )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+	TrotListActual *la = NULL;
+	TrotListActual *laNext = NULL;
+
+
+	/* PRECOND */
+	ERR_IF( program == NULL, TROT_RC_ERROR_PRECOND );
+	ERR_IF(    mode != TROT_GC_IMMEDIATE
+	        && mode != TROT_GC_DEFERRED
+	        && mode != TROT_GC_CYCLES,
+	        TROT_RC_ERROR_PRECOND );
+	ERR_IF(    mode == TROT_GC_DEFERRED
+	        && program->gcMode != TROT_GC_DEFERRED
+	        && program->memoryUsed != 0,
+	        TROT_RC_ERROR_PRECOND );
+
+
+	/* CODE */
+	if ( program->gcMode == TROT_GC_DEFERRED && mode != TROT_GC_DEFERRED )
+	{
+		/* nothing would free the garbage once we stop deferring */
+		trotListCollect( program );
+
+		/* 'is list reachable' needs flagVisited to be 0, and nothing may
+		   follow heapNext into lists that get freed later */
+		la = program->heap;
+		while ( la != NULL )
+		{
+			laNext = la->heapNext;
+
+			la->flagVisited = 0;
+			la->heapNext = NULL;
+
+			la = laNext;
+		}
+
+		program->heap = NULL;
+	}
+
+	if ( program->gcMode == TROT_GC_CYCLES && mode != TROT_GC_CYCLES )
+	{
+		/* nothing would free garbage cycles once we stop looking for them */
+		trotListCollectCycles( program );
+	}
+
+	program->gcMode = mode;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Frees every list that's no longer reachable. Only does something
+		if the program's mode is TROT_GC_DEFERRED or TROT_GC_CYCLES.
+	\param[in] program Program.
+	\return TROT_RC
+*/
+TROT_RC trotProgramGcCollect( TrotProgram *program )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+
+	/* PRECOND */
+	ERR_IF( program == NULL, TROT_RC_ERROR_PRECOND );
+
+
+	/* CODE */
+	if (    program->gcMode == TROT_GC_DEFERRED
+	     && ( program->gcFrees > 0 || program->gcPhase != GC_PHASE_IDLE )
+	   )
+	{
+		trotListCollect( program );
+	}
+	else if ( program->gcMode == TROT_GC_CYCLES && program->gcRootsCount > 0 )
+	{
+		trotListCollectCycles( program );
+	}
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Does a step of collecting garbage, about as much work as the
+		program's budget. Starts a new collection if refs have been freed
+		since the last one started. Only does something if the program's
+		mode is TROT_GC_DEFERRED.
+	\param[in] program Program.
+	\param[out] finished 1 if there's no collection under way after this
+		step, 0 if there's more to do.
+	\return TROT_RC
+*/
+TROT_RC trotProgramGcStep( TrotProgram *program, TROT_INT *finished )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+
+	/* PRECOND */
+	ERR_IF( program == NULL, TROT_RC_ERROR_PRECOND );
+	ERR_IF( finished == NULL, TROT_RC_ERROR_PRECOND );
+
+
+	/* CODE */
+	(*finished) = 1;
+
+	if (    program->gcMode == TROT_GC_DEFERRED
+	     && ( program->gcFrees > 0 || program->gcPhase != GC_PHASE_IDLE )
+	   )
+	{
+		(*finished) = trotListCollectStep( program, program->gcBudget );
+	}
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+/*!
+	\brief Sets how much work trotProgramGcStep does.
+	\param[in] program Program.
+	\param[in] budget Must be greater than 0. A list and an item in a list are
+		each about one unit of work.
+	\return TROT_RC
+*/
+TROT_RC trotProgramGcSetBudget( TrotProgram *program, TROT_INT budget )
+{
+	/* DATA */
+	TROT_RC rc = TROT_RC_SUCCESS;
+
+
+	/* PRECOND */
+	ERR_IF( program == NULL, TROT_RC_ERROR_PRECOND );
+	ERR_IF( budget <= 0, TROT_RC_ERROR_PRECOND );
+
+
+	/* CODE */
+	program->gcBudget = budget;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
 /******************************************************************************/
 /*!
 	\brief 
@@ -399,8 +674,10 @@ TROT_RC trotProgramSave( TrotProgram **program_F, char **savedProgram_A )
 
 /******************************************************************************/
 /*!
-	\brief 
-	\param 
+	\brief Frees a program and everything it allocated. Lists aren't walked,
+		the program's slabs and big blocks are just given back, so any lists
+		of the program still held are no longer valid.
+	\param[in] program_F Program to free.
 	\return TROT_RC
 */
 TROT_RC trotProgramFree( TrotProgram **program_F )
@@ -408,6 +685,11 @@ TROT_RC trotProgramFree( TrotProgram **program_F )
 	/* DATA */
 	TROT_RC rc = TROT_RC_SUCCESS;
 
+	TrotSlab *slab = NULL;
+	TrotBigBlock *bigBlock = NULL;
+
+	TrotAllocator allocator;
+
 
 	/* PRECOND */
 
@@ -418,8 +700,30 @@ TROT_RC trotProgramFree( TrotProgram **program_F )
 		goto cleanup;
 	}
 
-	/* TODO lThreadList */
-	TROT_HOOK_FREE( (*program_F) );
+	while ( (*program_F)->slabs != NULL )
+	{
+		slab = (*program_F)->slabs;
+		(*program_F)->slabs = slab->next;
+		PROGRAM_FREE( (*program_F), slab );
+	}
+
+	while ( (*program_F)->bigBlocks != NULL )
+	{
+		bigBlock = (*program_F)->bigBlocks;
+		(*program_F)->bigBlocks = bigBlock->next;
+		PROGRAM_FREE( (*program_F), bigBlock );
+	}
+
+	/* the program came from its own allocator too */
+	allocator = (*program_F)->allocator;
+	if ( allocator.freeFunc == NULL )
+	{
+		TROT_HOOK_FREE( (*program_F) );
+	}
+	else
+	{
+		allocator.freeFunc( allocator.context, (*program_F) );
+	}
 	(*program_F) = NULL;
 
 
@@ -429,3 +733,264 @@ TROT_RC trotProgramFree( TrotProgram **program_F )
 	return rc;
 }
 
+/******************************************************************************/
+/*!
+	\brief Allocates memory for a program. Sizes up to TROT_SLAB_MAX come from
+		the program's slabs, bigger sizes get a block of their own.
+	\param[in] program Program to allocate for.
+	\param[in] size Bytes to allocate.
+	\return Pointer to the memory, or NULL if it couldn't be allocated.
+*/
+void *trotSlabMalloc( TrotProgram *program, size_t size )
+{
+	/* DATA */
+	TrotSlabFree *object = NULL;
+
+
+	/* CODE */
+	if ( size == 0 || size > TROT_SLAB_MAX )
+	{
+		return bigBlockMalloc( program, size, 0 );
+	}
+
+	if ( program->slabFree[ SLAB_CLASS( size ) ] == NULL )
+	{
+		if ( slabRefill( program, SLAB_CLASS( size ) ) != 0 )
+		{
+			return NULL;
+		}
+	}
+
+	object = program->slabFree[ SLAB_CLASS( size ) ];
+	program->slabFree[ SLAB_CLASS( size ) ] = object->next;
+	program->slabObjects += 1;
+
+	return object;
+}
+
+/******************************************************************************/
+/*!
+	\brief Like trotSlabMalloc, but the memory is set to 0.
+	\param[in] program Program to allocate for.
+	\param[in] size Bytes to allocate.
+	\return Pointer to the memory, or NULL if it couldn't be allocated.
+*/
+void *trotSlabCalloc( TrotProgram *program, size_t size )
+{
+	/* DATA */
+	void *p = NULL;
+
+
+	/* CODE */
+	if ( size == 0 || size > TROT_SLAB_MAX )
+	{
+		return bigBlockMalloc( program, size, 1 );
+	}
+
+	p = trotSlabMalloc( program, size );
+	if ( p != NULL )
+	{
+		memset( p, 0, size );
+	}
+
+	return p;
+}
+
+/******************************************************************************/
+/*!
+	\brief Changes the size of memory from trotSlabMalloc or trotSlabCalloc.
+		Big blocks are reallocated in place when the allocator can, anything
+		else is copied to new memory.
+	\param[in] program Program the memory was allocated for.
+	\param[in] p Memory to resize, or NULL to allocate new memory.
+	\param[in] oldSize Bytes that were allocated.
+	\param[in] newSize Bytes wanted.
+	\return Pointer to the memory, or NULL if it couldn't be allocated, in
+		which case p is unchanged.
+*/
+void *trotSlabRealloc( TrotProgram *program, void *p, size_t oldSize, size_t newSize )
+{
+	/* DATA */
+	TrotBigBlock *bigBlock = NULL;
+	void *newP = NULL;
+
+
+	/* CODE */
+	if ( p == NULL )
+	{
+		return trotSlabMalloc( program, newSize );
+	}
+
+	if ( oldSize > TROT_SLAB_MAX && newSize > TROT_SLAB_MAX )
+	{
+		bigBlock = PROGRAM_REALLOC( program, ( (char *)p ) - TROT_SLAB_GRAIN, TROT_SLAB_GRAIN + newSize );
+		if ( bigBlock == NULL )
+		{
+			return NULL;
+		}
+
+		/* the block may have moved, so fix its neighbors */
+		if ( bigBlock->prev == NULL )
+		{
+			program->bigBlocks = bigBlock;
+		}
+		else
+		{
+			bigBlock->prev->next = bigBlock;
+		}
+
+		if ( bigBlock->next != NULL )
+		{
+			bigBlock->next->prev = bigBlock;
+		}
+
+		return ( (char *)bigBlock ) + TROT_SLAB_GRAIN;
+	}
+
+	newP = trotSlabMalloc( program, newSize );
+	if ( newP == NULL )
+	{
+		return NULL;
+	}
+
+	memcpy( newP, p, oldSize < newSize ? oldSize : newSize );
+
+	trotSlabFree( program, p, oldSize );
+
+	return newP;
+}
+
+/******************************************************************************/
+/*!
+	\brief Frees memory from trotSlabMalloc or trotSlabCalloc. Slab objects go
+		back on their free list, the slab itself is kept until the program is
+		freed.
+	\param[in] program Program the memory was allocated for.
+	\param[in] p Memory to free.
+	\param[in] size Bytes that were allocated.
+	\return void
+*/
+void trotSlabFree( TrotProgram *program, void *p, size_t size )
+{
+	/* DATA */
+	TrotSlabFree *object = p;
+	TrotBigBlock *bigBlock = NULL;
+
+
+	/* CODE */
+	if ( size == 0 || size > TROT_SLAB_MAX )
+	{
+		bigBlock = (TrotBigBlock *)( ( (char *)p ) - TROT_SLAB_GRAIN );
+
+		if ( bigBlock->prev == NULL )
+		{
+			program->bigBlocks = bigBlock->next;
+		}
+		else
+		{
+			bigBlock->prev->next = bigBlock->next;
+		}
+
+		if ( bigBlock->next != NULL )
+		{
+			bigBlock->next->prev = bigBlock->prev;
+		}
+
+		PROGRAM_FREE( program, bigBlock );
+		return;
+	}
+
+	object->next = program->slabFree[ SLAB_CLASS( size ) ];
+	program->slabFree[ SLAB_CLASS( size ) ] = object;
+	program->slabObjects -= 1;
+
+	return;
+}
+
+/******************************************************************************/
+/*!
+	\brief Allocates a new slab and puts its objects on the free list.
+	\param[in] program Program to allocate for.
+	\param[in] slabClass Which size of objects the slab holds.
+	\return 0 on success, -1 if the slab couldn't be allocated.
+*/
+static int slabRefill( TrotProgram *program, TROT_INT slabClass )
+{
+	/* DATA */
+	size_t objectSize = ( slabClass + 1 ) * TROT_SLAB_GRAIN;
+	size_t slabSize = TROT_SLAB_GRAIN + ( objectSize * TROT_SLAB_OBJECTS );
+
+	TrotSlab *slab = NULL;
+	TrotSlabFree *object = NULL;
+
+	TROT_INT i = 0;
+
+
+	/* CODE */
+	PARANOID_ERR_IF( program->slabFree[ slabClass ] != NULL );
+
+	slab = PROGRAM_MALLOC( program, slabSize );
+	if ( slab == NULL )
+	{
+		return -1;
+	}
+
+	slab->next = program->slabs;
+	program->slabs = slab;
+	program->slabCount += 1;
+	program->slabBytes += slabSize;
+
+	/* push objects from the end, so they come off the free list in order */
+	i = TROT_SLAB_OBJECTS;
+	while ( i > 0 )
+	{
+		i -= 1;
+
+		object = (TrotSlabFree *)( ( (char *)slab ) + TROT_SLAB_GRAIN + ( objectSize * i ) );
+		object->next = program->slabFree[ slabClass ];
+		program->slabFree[ slabClass ] = object;
+	}
+
+	return 0;
+}
+
+/******************************************************************************/
+/*!
+	\brief Allocates a block too big for a slab, and links it into the program.
+	\param[in] program Program to allocate for.
+	\param[in] size Bytes to allocate.
+	\param[in] zero 1 if the memory should be set to 0.
+	\return Pointer to the memory, or NULL if it couldn't be allocated.
+*/
+static void *bigBlockMalloc( TrotProgram *program, size_t size, int zero )
+{
+	/* DATA */
+	TrotBigBlock *bigBlock = NULL;
+
+
+	/* CODE */
+	if ( zero )
+	{
+		bigBlock = PROGRAM_CALLOC( program, TROT_SLAB_GRAIN + size );
+	}
+	else
+	{
+		bigBlock = PROGRAM_MALLOC( program, TROT_SLAB_GRAIN + size );
+	}
+
+	if ( bigBlock == NULL )
+	{
+		return NULL;
+	}
+
+	bigBlock->prev = NULL;
+	bigBlock->next = program->bigBlocks;
+	if ( program->bigBlocks != NULL )
+	{
+		program->bigBlocks->prev = bigBlock;
+	}
+	program->bigBlocks = bigBlock;
+
+	return ( (char *)bigBlock ) + TROT_SLAB_GRAIN;
+}
+
@@ -59,6 +59,7 @@ int main( int argc, char **argv )
 	int flagTestBadTypesIndices = 0;
 	int flagTestListFunctions = 0;
 	int flagTestDecodingEncoding = 0;
+	int flagTestBenchmark = 0;
 
 	int flagTestAnySet = 0;
 
@@ -122,6 +123,11 @@ int main( int argc, char **argv )
 			flagTestDecodingEncoding = 1;
 			flagTestAnySet = 1;
 		}
+		else if ( strcmp( argValue, "bnc" ) == 0 )
+		{
+			flagTestBenchmark = 1;
+			flagTestAnySet = 1;
+		}
 		else
 		{
 			fprintf( stderr, "UNKNOWN TEST TO RUN: \"%s\"\n", argValue );
@@ -141,6 +147,7 @@ int main( int argc, char **argv )
 		fprintf( stderr, "                   bad = bad types and indices\n" );
 		fprintf( stderr, "                   lst = list functions\n" );
 		fprintf( stderr, "                   cod = decoding, encoding\n" );
+		fprintf( stderr, "                   bnc = benchmark list layouts, not part of all\n" );
 		fprintf( stderr, "\n" );
 
 		return -1;
@@ -162,10 +169,18 @@ int main( int argc, char **argv )
 	   100% code coverage without modifying our test cases */
 	TEST_ERR_IF( TROT_NODE_SIZE < 4 );
 
-	/* **************************************** */
-	TEST_ERR_IF( ( program = TROT_HOOK_CALLOC( 1, sizeof( *program ) ) ) == NULL );
+	/* Same for TROT_INDEX_SIZE. Index nodes need room to split in half. */
+	TEST_ERR_IF( TROT_INDEX_SIZE < 4 );
+
+	/* Slab objects are TROT_SLAB_GRAIN apart, and start TROT_SLAB_GRAIN into
+	   their slab. Big blocks also start TROT_SLAB_GRAIN in. */
+	TEST_ERR_IF( sizeof( TrotSlab ) > TROT_SLAB_GRAIN );
+	TEST_ERR_IF( sizeof( TrotBigBlock ) > TROT_SLAB_GRAIN );
+	TEST_ERR_IF( TROT_SLAB_GRAIN % sizeof( void * ) != 0 );
+	TEST_ERR_IF( TROT_SLAB_MAX % TROT_SLAB_GRAIN != 0 );
 
-	TEST_ERR_IF( trotProgramMemorySetLimit( program, TROT_INT_MAX ) != TROT_RC_SUCCESS );
+	/* **************************************** */
+	TEST_ERR_IF( trotProgramLoad( TROT_INT_MAX, NULL, "", &program ) != TROT_RC_SUCCESS );
 
 	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memUsed ) != TROT_RC_SUCCESS );
 	TEST_ERR_IF( memUsed != 0 );
@@ -218,6 +233,14 @@ int main( int argc, char **argv )
 	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memUsed ) != TROT_RC_SUCCESS );
 	TEST_ERR_IF( memUsed != 0 );
 
+	if ( flagTestBenchmark )
+	{
+		TEST_ERR_IF( testBenchmark( program ) != 0 );
+	}
+
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memUsed ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memUsed != 0 );
+
 	trotProgramFree( &program );
 
 	/* **************************************** */
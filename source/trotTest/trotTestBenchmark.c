@@ -0,0 +1,220 @@
+/*
+Copyright (c) 2010-2014 Jeremiah Martell
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    - Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    - Neither the name of Jeremiah Martell nor the name of GeekHorse nor the
+      name of Trot nor the names of its contributors may be used to endorse or
+      promote products derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/******************************************************************************/
+#include "trot.h"
+#include "trotInternal.h"
+
+#include "trotTestCommon.h"
+
+/******************************************************************************/
+#define BENCHMARK_COUNT ( TROT_MAX_CHILDREN < 100000 ? TROT_MAX_CHILDREN : 100000 )
+#define BENCHMARK_WALKS 20
+#define BENCHMARK_SHARED 100
+
+/******************************************************************************/
+/* every how many items is a list? 1 means every item is a list, 0 means no
+   items are lists */
+static int listEvery[] = { 0, 1, 2, 4, 16 };
+static const char *listEveryName[] =
+	{
+		"all ints",
+		"all lists",
+		"int/list alternating",
+		"list every 4th",
+		"list every 16th"
+	};
+
+/******************************************************************************/
+static int benchmarkPattern( TrotProgram *program, TrotList **lShared, int every, const char *name );
+static int countNodes( TrotList *l );
+
+/******************************************************************************/
+int testBenchmark( TrotProgram *program )
+{
+	/* DATA */
+	int rc = 0;
+
+	TrotList *lShared[ BENCHMARK_SHARED ];
+
+	unsigned int i = 0;
+
+
+	/* CODE */
+	printf( "Benchmarking list layouts, %d items, %d walks...\n", BENCHMARK_COUNT, BENCHMARK_WALKS ); fflush( stdout );
+
+	/* list items are twins of a few shared lists, so mostly node memory is
+	   counted. more than one, so no list ends up with a huge ref list. */
+	for ( i = 0; i < BENCHMARK_SHARED; i += 1 )
+	{
+		lShared[ i ] = NULL;
+	}
+	for ( i = 0; i < BENCHMARK_SHARED; i += 1 )
+	{
+		TEST_ERR_IF( trotListInit( program, &( lShared[ i ] ) ) != TROT_RC_SUCCESS );
+	}
+
+	for ( i = 0; i < ( sizeof( listEvery ) / sizeof( int ) ); i += 1 )
+	{
+		TEST_ERR_IF( benchmarkPattern( program, lShared, listEvery[ i ], listEveryName[ i ] ) != 0 );
+	}
+
+
+	/* CLEANUP */
+	cleanup:
+
+	for ( i = 0; i < BENCHMARK_SHARED; i += 1 )
+	{
+		trotListFree( program, &( lShared[ i ] ) );
+	}
+
+	return rc;
+}
+
+/******************************************************************************/
+static int benchmarkPattern( TrotProgram *program, TrotList **lShared, int every, const char *name )
+{
+	/* DATA */
+	int rc = 0;
+
+	TrotList *l = NULL;
+
+	TROT_INT memBefore = 0;
+	TROT_INT memAfter = 0;
+
+	TrotListCursor c;
+
+	TROT_INT i = 0;
+	int walk = 0;
+
+	TROT_INT kind = 0;
+	TROT_INT n = 0;
+	TROT_INT sum = 0;
+
+	clock_t start = 0;
+	double cursorTime = 0.0;
+	double indexTime = 0.0;
+
+
+	/* CODE */
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memBefore ) != TROT_RC_SUCCESS );
+
+	/* build */
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+
+	for ( i = 1; i <= BENCHMARK_COUNT; i += 1 )
+	{
+		if ( every != 0 && i % every == 0 )
+		{
+			TEST_ERR_IF( trotListAppendList( program, l, lShared[ i % BENCHMARK_SHARED ] ) != TROT_RC_SUCCESS );
+		}
+		else
+		{
+			TEST_ERR_IF( trotListAppendInt( program, l, i ) != TROT_RC_SUCCESS );
+		}
+	}
+
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memAfter ) != TROT_RC_SUCCESS );
+
+	/* walk with a cursor */
+	start = clock();
+	for ( walk = 0; walk < BENCHMARK_WALKS; walk += 1 )
+	{
+		TEST_ERR_IF( trotListCursorInit( program, l, &c ) != TROT_RC_SUCCESS );
+
+		for ( i = 1; i <= BENCHMARK_COUNT; i += 1 )
+		{
+			TEST_ERR_IF( trotListCursorNext( program, &c ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( trotListCursorGetKind( program, &c, &kind ) != TROT_RC_SUCCESS );
+
+			if ( kind == TROT_KIND_INT )
+			{
+				TEST_ERR_IF( trotListCursorGetInt( program, &c, &n ) != TROT_RC_SUCCESS );
+				sum += n;
+			}
+		}
+	}
+	cursorTime = (double)( clock() - start ) / CLOCKS_PER_SEC;
+
+	/* walk by index */
+	start = clock();
+	for ( walk = 0; walk < BENCHMARK_WALKS; walk += 1 )
+	{
+		for ( i = 1; i <= BENCHMARK_COUNT; i += 1 )
+		{
+			TEST_ERR_IF( trotListGetKind( program, l, i, &kind ) != TROT_RC_SUCCESS );
+
+			if ( kind == TROT_KIND_INT )
+			{
+				TEST_ERR_IF( trotListGetInt( program, l, i, &n ) != TROT_RC_SUCCESS );
+				sum -= n;
+			}
+		}
+	}
+	indexTime = (double)( clock() - start ) / CLOCKS_PER_SEC;
+
+	/* both walks should have seen the same ints */
+	TEST_ERR_IF( sum != 0 );
+
+	printf( "  %-22s nodes %7d  bytes %9d  cursor walk %6.3fs  index walk %6.3fs\n",
+		name,
+		countNodes( l ),
+		memAfter - memBefore,
+		cursorTime,
+		indexTime
+	);
+	fflush( stdout );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &l );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int countNodes( TrotList *l )
+{
+	/* DATA */
+	TrotListActual *la = l->laPointsTo;
+	TrotListNode *node = la->headNode.next;
+	int nodes = 0;
+
+
+	/* CODE */
+	while ( node != &( la->headNode ) )
+	{
+		nodes += 1;
+		node = node->next;
+	}
+
+	return nodes;
+}
@@ -394,6 +394,64 @@ int check( TrotProgram *program, TrotList *l, TROT_INT index, TROT_INT valueToCh
 	return rc;
 }
 
+/******************************************************************************/
+static int checkIndex( TrotListIndexNode *in, TrotListIndexNode *parent, TROT_INT slot, TrotListNode **node, TROT_INT *total )
+{
+	/* DATA */
+	int rc = 0;
+
+	TrotListNode *leaf = NULL;
+	TrotListIndexNode *child = NULL;
+
+	TROT_INT i = 0;
+	TROT_INT subTotal = 0;
+
+
+	/* CODE */
+	TEST_ERR_IF( in == NULL );
+	TEST_ERR_IF( in->parent != parent );
+	TEST_ERR_IF( in->slot != slot );
+	TEST_ERR_IF( in->level < 1 );
+	TEST_ERR_IF( in->used < 1 );
+	TEST_ERR_IF( in->used > TROT_INDEX_SIZE );
+
+	for ( i = 0; i < in->used; i += 1 )
+	{
+		TEST_ERR_IF( in->children[ i ] == NULL );
+
+		if ( in->level == 1 )
+		{
+			/* leaves must be in the same order as the list's nodes */
+			leaf = (TrotListNode *)in->children[ i ];
+			TEST_ERR_IF( leaf != (*node) );
+			TEST_ERR_IF( leaf->parent != in );
+			TEST_ERR_IF( leaf->slot != i );
+			TEST_ERR_IF( in->counts[ i ] != leaf->count );
+
+			(*node) = leaf->next;
+		}
+		else
+		{
+			child = (TrotListIndexNode *)in->children[ i ];
+			TEST_ERR_IF( child->level != in->level - 1 );
+
+			subTotal = 0;
+			TEST_ERR_IF( checkIndex( child, in, i, node, &subTotal ) != 0 );
+			TEST_ERR_IF( in->counts[ i ] != subTotal );
+		}
+
+		(*total) += in->counts[ i ];
+	}
+
+	return 0;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
 /******************************************************************************/
 int checkList( TrotProgram *program, TrotList *l )
 {
@@ -403,9 +461,11 @@ int checkList( TrotProgram *program, TrotList *l )
 	TrotListActual *la = NULL;
 	TrotListActual *subLa = NULL;
 	TrotListNode *node = NULL;
+	TrotListNode *prevNode = NULL;
 
-	TrotListRefListNode *refNode = NULL;
-	TrotListRefListNode *subRefNode = NULL;
+	TrotList *ref = NULL;
+	TrotList *refPrev = NULL;
+	TrotList *subRef = NULL;
 
 	int i = 0;
 
@@ -413,6 +473,12 @@ int checkList( TrotProgram *program, TrotList *l )
 
 	int foundLr = 0;
 	int foundRef = 0;
+	int foundInline = 0;
+
+	int foundParentedRef = 0;
+
+	TROT_INT indexTotal = 0;
+	TROT_INT fingerStart = 0;
 
 
 	/* CODE */
@@ -427,79 +493,118 @@ int checkList( TrotProgram *program, TrotList *l )
 	TEST_ERR_IF( la == NULL );
 	TEST_ERR_IF( la->childrenCount < 0 );
 
-	TEST_ERR_IF( la->head == NULL );
-	TEST_ERR_IF( la->head->n != NULL );
-	TEST_ERR_IF( la->head->l != NULL );
-	TEST_ERR_IF( la->head->next == NULL );
-	TEST_ERR_IF( la->head->prev == NULL );
-	TEST_ERR_IF( la->head->prev != la->head );
+	TEST_ERR_IF( la->headNode.kind != 0 );
+	TEST_ERR_IF( la->headNode.next == NULL );
 
-	TEST_ERR_IF( la->tail == NULL );
-	TEST_ERR_IF( la->tail->n != NULL );
-	TEST_ERR_IF( la->tail->l != NULL );
-	TEST_ERR_IF( la->tail->next == NULL );
-	TEST_ERR_IF( la->tail->prev == NULL );
-	TEST_ERR_IF( la->tail->next != la->tail );
+	TEST_ERR_IF( la->last == NULL );
+	TEST_ERR_IF( la->last->next != &( la->headNode ) );
+	TEST_ERR_IF( trotListNodePrev( la, &( la->headNode ) ) != la->last );
 
 	/* *** */
-	node = la->head->next;
+	node = la->headNode.next;
 	TEST_ERR_IF( node == NULL );
 
-	while ( node != la->tail )
+	prevNode = &( la->headNode );
+	while ( node != &( la->headNode ) )
 	{
 		TEST_ERR_IF( node->next == NULL );
 		TEST_ERR_IF( node->next == node );
-		TEST_ERR_IF( node->prev == NULL );
-		TEST_ERR_IF( node->prev == node );
-		TEST_ERR_IF( node->next->prev != node );
-		TEST_ERR_IF( node->prev->next != node );
+		TEST_ERR_IF( trotListNodePrev( la, node ) != prevNode );
+		prevNode = node;
 
 		TEST_ERR_IF( node->count <= 0 );
 		realCount += node->count;
 
-		TEST_ERR_IF(    node->n == NULL
-		             && node->l == NULL
-		           );
+		if ( node == &( la->inlineNode ) )
+		{
+			TEST_ERR_IF( node->capacity <= 0 );
+			TEST_ERR_IF( node->capacity > TROT_NODE_SIZE );
+			foundInline = 1;
+		}
+		else if ( node->kind == NODE_KIND_INT && node->width == NODE_WIDTH_RUN )
+		{
+			TEST_ERR_IF( node->capacity != node->count );
+			TEST_ERR_IF( node == &( la->inlineNode ) );
+		}
+		else
+		{
+			TEST_ERR_IF( node->capacity < TROT_NODE_SIZE );
+			TEST_ERR_IF(    node->capacity > TROT_NODE_SIZE_MAX
+			             && node->capacity != TROT_NODE_SIZE
+			           );
+		}
+		TEST_ERR_IF( node->count > node->capacity );
 
-		TEST_ERR_IF(    node->n != NULL
-		             && node->l != NULL
+		TEST_ERR_IF(    node->kind != NODE_KIND_INT
+		             && node->kind != NODE_KIND_LIST
+		             && node->kind != NODE_KIND_MIXED
 		           );
 
-		if ( node->n != NULL )
+		if ( node->kind == NODE_KIND_INT )
 		{
-			TEST_ERR_IF( node->l != NULL );
+			TEST_ERR_IF(    node->width != NODE_WIDTH_8
+			             && node->width != NODE_WIDTH_16
+			             && node->width != NODE_WIDTH_FULL
+			             && node->width != NODE_WIDTH_RUN
+			           );
+		}
+		else if ( node->kind == NODE_KIND_MIXED )
+		{
+			TEST_ERR_IF( node->width != 0 );
+
+			i = 0;
+			while( i < node->count )
+			{
+				TEST_ERR_IF(    NODE_SLOTS( node )[ i ].kind != NODE_KIND_INT
+				             && NODE_SLOTS( node )[ i ].kind != NODE_KIND_LIST
+				           );
+
+				if ( NODE_SLOTS( node )[ i ].kind == NODE_KIND_LIST )
+				{
+					TEST_ERR_IF( NODE_SLOTS( node )[ i ].u.l == NULL );
+					TEST_ERR_IF( NODE_SLOTS( node )[ i ].u.l->laParent != la );
+				}
+
+				i += 1;
+			}
+			while ( i < node->capacity )
+			{
+				TEST_ERR_IF( NODE_SLOTS( node )[ i ].kind != 0 );
+				TEST_ERR_IF( NODE_SLOTS( node )[ i ].u.l != NULL );
+
+				i += 1;
+			}
 		}
 		else
 		{
-			TEST_ERR_IF( node->l == NULL );
-			TEST_ERR_IF( node->n != NULL );
+			TEST_ERR_IF( node->width != 0 );
 
 			i = 0;
 			while( i < node->count )
 			{
-				TEST_ERR_IF( node->l[ i ] == NULL );
+				TEST_ERR_IF( NODE_LISTS( node )[ i ] == NULL );
 
 				foundRef = 0;
-				subLa = node->l[ i ]->laPointsTo;
-				subRefNode = subLa->refList;
-				while ( subRefNode != NULL && foundRef == 0 )
+				subLa = NODE_LISTS( node )[ i ]->laPointsTo;
+				subRef = subLa->refList;
+				while ( subRef != NULL && foundRef == 0 )
 				{
-					if ( subRefNode->l->laParent == la )
+					if ( subRef->laParent == la )
 					{
 						foundRef = 1;
 						break;
 					}
 
-					subRefNode = subRefNode->next;
+					subRef = subRef->refNext;
 				}
 
 				TEST_ERR_IF( foundRef == 0 );
 
 				i += 1;
 			}
-			while ( i < TROT_NODE_SIZE )
+			while ( i < node->capacity )
 			{
-				TEST_ERR_IF( node->l[ i ] != NULL );
+				TEST_ERR_IF( NODE_LISTS( node )[ i ] != NULL );
 
 				i += 1;
 			}
@@ -509,6 +614,14 @@ int checkList( TrotProgram *program, TrotList *l )
 		node = node->next;
 	}
 
+	TEST_ERR_IF( la->last != prevNode );
+
+	/* the inline node is only in use when it's in the list */
+	if ( foundInline == 0 )
+	{
+		TEST_ERR_IF( la->inlineNode.kind != 0 );
+	}
+
 	if ( realCount != la->childrenCount )
 	{
 		printf( "realCount = (%d)\n", realCount );
@@ -518,23 +631,69 @@ int checkList( TrotProgram *program, TrotList *l )
 		TEST_ERR_IF( 1 );
 	}
 
+	/* check index */
+	node = la->headNode.next;
+	if ( la->indexRoot == NULL )
+	{
+		/* only lists with less than 2 nodes don't need an index */
+		if ( node != &( la->headNode ) )
+		{
+			TEST_ERR_IF( node->parent != NULL );
+			TEST_ERR_IF( node->next != &( la->headNode ) );
+		}
+	}
+	else
+	{
+		TEST_ERR_IF( la->indexRoot->used < 2 );
+		TEST_ERR_IF( checkIndex( la->indexRoot, NULL, 0, &node, &indexTotal ) != 0 );
+		TEST_ERR_IF( node != &( la->headNode ) );
+		TEST_ERR_IF( indexTotal != la->childrenCount );
+	}
+
+	/* check finger */
+	if ( la->fingerNode != NULL )
+	{
+		node = la->headNode.next;
+		while ( node != la->fingerNode )
+		{
+			TEST_ERR_IF( node == &( la->headNode ) );
+
+			fingerStart += node->count;
+			node = node->next;
+		}
+
+		TEST_ERR_IF( fingerStart != la->fingerStart );
+	}
+
 	/* *** */
-	refNode = la->refList;
-	while ( refNode != NULL )
+	ref = la->refList;
+	while ( ref != NULL )
 	{
-		TEST_ERR_IF( refNode->l == NULL );
-		TEST_ERR_IF( refNode->l->laPointsTo == NULL );
-		TEST_ERR_IF( refNode->l->laPointsTo != la );
+		TEST_ERR_IF( ref->laPointsTo == NULL );
+		TEST_ERR_IF( ref->laPointsTo != la );
+		TEST_ERR_IF( ref != la->refList && ref->refPrev != refPrev );
 
-		if ( refNode->l == l )
+		if ( ref == l )
 		{
 			foundLr = 1;
 		}
 
-		refNode = refNode->next;
+		/* client refs come first */
+		if ( ref->laParent == NULL )
+		{
+			TEST_ERR_IF( foundParentedRef );
+		}
+		else
+		{
+			foundParentedRef = 1;
+		}
+
+		refPrev = ref;
+		ref = ref->refNext;
 	}
 
 	TEST_ERR_IF( foundLr == 0 );
+	TEST_ERR_IF( la->refList->refPrev != refPrev );
 
 	return 0;
 
@@ -558,7 +717,7 @@ void printList( TrotProgram *program, TrotList *l, int indent )
 {
 	/* DATA */
 	TrotListActual *la = l->laPointsTo;
-	TrotListNode *node = la->head->next;
+	TrotListNode *node = la->headNode.next;
 	int i = 0;
 	/* TrotListRefListNode *refNode = la->refListHead->next; */
 
@@ -584,18 +743,35 @@ void printList( TrotProgram *program, TrotList *l, int indent )
 	printf( "\n" );
 */
 
-	while ( node != la->tail )
+	while ( node != &( la->headNode ) )
 	{
-		if ( node->n != NULL )
+		if ( node->kind == NODE_KIND_INT )
 		{
 			printIndent( indent );
 			printf( "I " );
 			for ( i = 0; i < (node->count); i += 1 )
 			{
-				printf( "%d ", node->n[ i ] );
+				printf( "%d ", NODE_GET_INT( node, i ) );
 			}
 			printf( "\n" );
 		}
+		else if ( node->kind == NODE_KIND_MIXED )
+		{
+			printIndent( indent );
+			printf( "M\n" );
+			for ( i = 0; i < (node->count); i += 1 )
+			{
+				printIndent( indent );
+				if ( NODE_SLOTS( node )[ i ].kind == NODE_KIND_INT )
+				{
+					printf( "%d\n", NODE_SLOTS( node )[ i ].u.n );
+				}
+				else
+				{
+					printList( program, NODE_SLOTS( node )[ i ].u.l, indent + 1 );
+				}
+			}
+		}
 		else /* node is list kind */
 		{
 			printIndent( indent );
@@ -603,8 +779,8 @@ void printList( TrotProgram *program, TrotList *l, int indent )
 			for ( i = 0; i < (node->count); i += 1 )
 			{
 				printIndent( indent );
-				/* printf( "(%p>%p)\n", (void *)node->l[ i ], (void *)node->l[ i ]->laPointsTo ); */
-				printList( program, node->l[ i ], indent + 1 );
+				/* printf( "(%p>%p)\n", (void *)NODE_LISTS( node )[ i ], (void *)NODE_LISTS( node )[ i ]->laPointsTo ); */
+				printList( program, NODE_LISTS( node )[ i ], indent + 1 );
 			}
 		}
 
@@ -741,6 +917,7 @@ TROT_RC listToCString( TrotProgram *program, TrotList *l, char **cString_A )
 	TROT_INT count = 0;
 	TROT_INT i = 1;
 
+	TrotListCursor cursor;
 	TROT_INT c = 0;
 
 
@@ -754,10 +931,16 @@ TROT_RC listToCString( TrotProgram *program, TrotList *l, char **cString_A )
 
 	TROT_MALLOC( newCString, count + 1 );
 
+	rc = trotListCursorInit( program, l, &cursor );
+	ERR_IF_PASSTHROUGH;
+
 	i = 1;
 	while ( i <= count )
 	{
-		rc = trotListGetInt( program, l, i, &c );
+		rc = trotListCursorNext( program, &cursor );
+		ERR_IF_PASSTHROUGH;
+
+		rc = trotListCursorGetInt( program, &cursor, &c );
 		ERR_IF_PASSTHROUGH;
 
 		PARANOID_ERR_IF( c < 0 );
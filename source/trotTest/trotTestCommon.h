@@ -62,6 +62,7 @@ int testMemory( TrotProgram *program );
 int testBadTypesAndIndices( TrotProgram *program );
 int testListFunctions( TrotProgram *program );
 int testDecodingEncoding( TrotProgram *program );
+int testBenchmark( TrotProgram *program );
 
 /******************************************************************************/
 /* create functions */
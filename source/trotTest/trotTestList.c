@@ -27,6 +27,9 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+/******************************************************************************/
+#define TROT_FILE_NUMBER 502
+
 /******************************************************************************/
 #include "trot.h"
 #include "trotInternal.h"
@@ -67,6 +70,28 @@ static int testAddAtOddIndices( TrotProgram *program, TrotList *l, int intsOrLis
 
 static int testReplace( TrotProgram *program, TrotList *l, int intsOrLists, int positiveOrNegativeIndices );
 
+static int testCursor( TrotProgram *program, TrotList *l );
+static int cursorCheck( TrotProgram *program, TrotListCursor *c, TROT_INT valueToCheckAgainst );
+
+static int testBulkInts( TrotProgram *program, TrotList *l );
+
+static int testRanges( TrotProgram *program, TrotList *l );
+static int checkRange( TrotProgram *program, TrotList *l, TROT_INT index, TROT_INT count, TROT_INT firstValue );
+
+static int testConcatAndSplit( TrotProgram *program, TrotList *l );
+static int testConcatSizes( TrotProgram *program );
+
+static int testCompact( TrotProgram *program );
+static int testMixedNodes( TrotProgram *program );
+static int testInlineNode( TrotProgram *program );
+static int testNodeGrowth( TrotProgram *program );
+static TROT_INT biggestNode( TrotList *l );
+static int testIntWidths( TrotProgram *program );
+static TROT_INT widestNode( TrotList *l );
+static int testRuns( TrotProgram *program );
+static int checkInts( TrotProgram *program, TrotList *l, TROT_INT *expected, TROT_INT count );
+static TROT_INT countNodes( TrotList *l );
+
 static int (*testFunctions[])( TrotProgram *, TrotList *, int, int, int ) = 
 	{
 		testPrepend,
@@ -163,10 +188,40 @@ int testListFunctions( TrotProgram *program )
 		TEST_ERR_IF( trotListAppendList( program, l, l ) != TROT_RC_ERROR_LIST_OVERFLOW );
 		TEST_ERR_IF( trotListInsertInt( program, l, 1, 1 ) != TROT_RC_ERROR_LIST_OVERFLOW );
 		TEST_ERR_IF( trotListInsertList( program, l, 1, l ) != TROT_RC_ERROR_LIST_OVERFLOW );
+		TEST_ERR_IF( trotListAppendInts( program, l, &index, 1 ) != TROT_RC_ERROR_LIST_OVERFLOW );
+		TEST_ERR_IF( trotListInsertInts( program, l, 1, &index, 1 ) != TROT_RC_ERROR_LIST_OVERFLOW );
 
 		trotListFree( program, &l );
 	}
 
+	/* test concat and split on lists with big indexes */
+	printf( "  Testing concat and split...\n" ); fflush( stdout );
+	TEST_ERR_IF( testConcatSizes( program ) != 0 );
+
+	/* test compacting and merging nodes */
+	printf( "  Testing compact...\n" ); fflush( stdout );
+	TEST_ERR_IF( testCompact( program ) != 0 );
+
+	/* test mixed nodes */
+	printf( "  Testing mixed nodes...\n" ); fflush( stdout );
+	TEST_ERR_IF( testMixedNodes( program ) != 0 );
+
+	/* test the node inside each list */
+	printf( "  Testing inline node...\n" ); fflush( stdout );
+	TEST_ERR_IF( testInlineNode( program ) != 0 );
+
+	/* test bigger nodes for bigger lists */
+	printf( "  Testing node growth...\n" ); fflush( stdout );
+	TEST_ERR_IF( testNodeGrowth( program ) != 0 );
+
+	/* test narrow int nodes */
+	printf( "  Testing int widths...\n" ); fflush( stdout );
+	TEST_ERR_IF( testIntWidths( program ) != 0 );
+
+	/* test run nodes */
+	printf( "  Testing runs...\n" ); fflush( stdout );
+	TEST_ERR_IF( testRuns( program ) != 0 );
+
 	/* *** */
 	printf( "  Testing rest of primary functions...\n" ); fflush( stdout );
 	count = 0;
@@ -244,6 +299,38 @@ int testListFunctions( TrotProgram *program )
 
 			trotListFree( program, &l );
 
+			/* cursor */
+			printf( "." ); fflush( stdout );
+
+			TEST_ERR_IF( createFunctions[ i ]( program, &l, count ) != 0 );
+			TEST_ERR_IF( testCursor( program, l ) != 0 );
+
+			trotListFree( program, &l );
+
+			/* bulk ints */
+			printf( "." ); fflush( stdout );
+
+			TEST_ERR_IF( createFunctions[ i ]( program, &l, count ) != 0 );
+			TEST_ERR_IF( testBulkInts( program, l ) != 0 );
+
+			trotListFree( program, &l );
+
+			/* ranges */
+			printf( "." ); fflush( stdout );
+
+			TEST_ERR_IF( createFunctions[ i ]( program, &l, count ) != 0 );
+			TEST_ERR_IF( testRanges( program, l ) != 0 );
+
+			trotListFree( program, &l );
+
+			/* concat and split */
+			printf( "." ); fflush( stdout );
+
+			TEST_ERR_IF( createFunctions[ i ]( program, &l, count ) != 0 );
+			TEST_ERR_IF( testConcatAndSplit( program, l ) != 0 );
+
+			trotListFree( program, &l );
+
 			i += 1;
 		}
 
@@ -1134,3 +1221,1565 @@ static int testReplace( TrotProgram *program, TrotList *l, int intsOrLists, int
 	return rc;
 }
 
+
+/******************************************************************************/
+static int testCursor( TrotProgram *program, TrotList *l )
+{
+	/* DATA */
+	int rc = 0;
+
+	TrotListCursor c;
+
+	TROT_INT count = 0;
+	TROT_INT countAfter = 0;
+	TROT_INT index = 0;
+	TROT_INT n = 0;
+
+	TrotList *newL = NULL;
+
+
+	/* CODE */
+	TEST_ERR_IF( trotListGetCount( program, l, &count ) != TROT_RC_SUCCESS );
+
+	/* walk forward */
+	TEST_ERR_IF( trotListCursorInit( program, l, &c ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListCursorGetInt( program, &c, &n ) != TROT_RC_ERROR_BAD_INDEX );
+
+	index = 1;
+	while ( index <= count )
+	{
+		TEST_ERR_IF( trotListCursorNext( program, &c ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( c.index != index );
+		TEST_ERR_IF( cursorCheck( program, &c, index ) != 0 );
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( trotListCursorNext( program, &c ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( c.index != count + 1 );
+	TEST_ERR_IF( trotListCursorNext( program, &c ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListCursorGetKind( program, &c, &n ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListCursorRemove( program, &c ) != TROT_RC_ERROR_BAD_INDEX );
+
+	/* walk backward */
+	index = count;
+	while ( index >= 1 )
+	{
+		TEST_ERR_IF( trotListCursorPrev( program, &c ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( c.index != index );
+		TEST_ERR_IF( cursorCheck( program, &c, index ) != 0 );
+
+		index -= 1;
+	}
+
+	TEST_ERR_IF( trotListCursorPrev( program, &c ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( c.index != 0 );
+	TEST_ERR_IF( trotListCursorPrev( program, &c ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListCursorGetList( program, &c, &newL ) != TROT_RC_ERROR_BAD_INDEX );
+
+	/* seek */
+	index = 1;
+	while ( index <= count )
+	{
+		TEST_ERR_IF( trotListCursorSeek( program, &c, index ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( cursorCheck( program, &c, index ) != 0 );
+
+		TEST_ERR_IF( trotListCursorSeek( program, &c, -index ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( c.index != count - index + 1 );
+		TEST_ERR_IF( cursorCheck( program, &c, count - index + 1 ) != 0 );
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( trotListCursorSeek( program, &c, 0 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListCursorSeek( program, &c, count + 1 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListCursorSeek( program, &c, count + 2 ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListCursorSeek( program, &c, -( count + 2 ) ) != TROT_RC_ERROR_BAD_INDEX );
+
+	/* insert before every item, alternating ints and lists */
+	TEST_ERR_IF( trotListCursorInit( program, l, &c ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListCursorNext( program, &c ) != TROT_RC_SUCCESS );
+
+	index = 1;
+	while ( index <= count + 1 )
+	{
+		if ( index % 2 == 0 )
+		{
+			TEST_ERR_IF( trotListCursorInsertInt( program, &c, -index ) != TROT_RC_SUCCESS );
+		}
+		else
+		{
+			TEST_ERR_IF( trotListInit( program, &newL ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( trotListAppendInt( program, newL, -index ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( trotListCursorInsertList( program, &c, newL ) != TROT_RC_SUCCESS );
+			trotListFree( program, &newL );
+		}
+
+		TEST_ERR_IF( cursorCheck( program, &c, -index ) != 0 );
+
+		/* skip the new item and the original item */
+		TEST_ERR_IF( trotListCursorNext( program, &c ) != TROT_RC_SUCCESS );
+		if ( index <= count )
+		{
+			TEST_ERR_IF( cursorCheck( program, &c, index ) != 0 );
+			TEST_ERR_IF( trotListCursorNext( program, &c ) != TROT_RC_SUCCESS );
+		}
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+
+	TEST_ERR_IF( trotListGetCount( program, l, &countAfter ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( countAfter != ( count * 2 ) + 1 );
+
+	index = 1;
+	while ( index <= count )
+	{
+		TEST_ERR_IF( check( program, l, index * 2, index ) != 0 );
+		TEST_ERR_IF( check( program, l, ( index * 2 ) - 1, -index ) != 0 );
+
+		index += 1;
+	}
+
+	/* remove what we inserted */
+	TEST_ERR_IF( trotListCursorSeek( program, &c, 1 ) != TROT_RC_SUCCESS );
+
+	index = 1;
+	while ( index <= count + 1 )
+	{
+		TEST_ERR_IF( trotListCursorRemove( program, &c ) != TROT_RC_SUCCESS );
+
+		if ( index <= count )
+		{
+			TEST_ERR_IF( cursorCheck( program, &c, index ) != 0 );
+			TEST_ERR_IF( trotListCursorNext( program, &c ) != TROT_RC_SUCCESS );
+		}
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( c.index != count + 1 );
+
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+
+	TEST_ERR_IF( trotListGetCount( program, l, &countAfter ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( countAfter != count );
+
+	index = 1;
+	while ( index <= count )
+	{
+		TEST_ERR_IF( check( program, l, index, index ) != 0 );
+
+		index += 1;
+	}
+
+	return 0;
+
+
+	/* CLEANUP */
+	cleanup:
+
+	printf( "\x1b[31;1mFAILED AT %d index:%d\n\x1b[0m", rc, index );
+
+	trotListFree( program, &newL );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int cursorCheck( TrotProgram *program, TrotListCursor *c, TROT_INT valueToCheckAgainst )
+{
+	/* DATA */
+	int rc = 0;
+
+	TROT_INT kind = 0;
+
+	TROT_INT valueInList = 0;
+
+	TrotList *subList = NULL;
+
+
+	/* CODE */
+	TEST_ERR_IF( trotListCursorGetKind( program, c, &kind ) != TROT_RC_SUCCESS );
+
+	if ( kind == TROT_KIND_INT )
+	{
+		TEST_ERR_IF( trotListCursorGetList( program, c, &subList ) != TROT_RC_ERROR_WRONG_KIND );
+		TEST_ERR_IF( trotListCursorGetInt( program, c, &valueInList ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( valueInList != valueToCheckAgainst );
+	}
+	else if ( kind == TROT_KIND_LIST )
+	{
+		TEST_ERR_IF( trotListCursorGetInt( program, c, &valueInList ) != TROT_RC_ERROR_WRONG_KIND );
+		TEST_ERR_IF( trotListCursorGetList( program, c, &subList ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( trotListGetInt( program, subList, 1, &valueInList ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( valueInList != valueToCheckAgainst );
+	}
+	else
+	{
+		TEST_ERR_IF( 1 );
+	}
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &subList );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int testBulkInts( TrotProgram *program, TrotList *l )
+{
+	/* DATA */
+	int rc = 0;
+
+	TROT_INT count = 0;
+	TROT_INT countAfter = 0;
+	TROT_INT bulkCount = MAGIC_NUMBER + 1;
+
+	TROT_INT *src = NULL;
+	TROT_INT *dst = NULL;
+
+	TROT_INT allInts = 0;
+	TROT_INT kind = 0;
+
+	TROT_INT index = 0;
+	TROT_INT i = 0;
+
+
+	/* CODE */
+	TEST_ERR_IF( trotListGetCount( program, l, &count ) != TROT_RC_SUCCESS );
+
+	TROT_CALLOC( src, bulkCount );
+	TROT_CALLOC( dst, count + bulkCount );
+
+	i = 0;
+	while ( i < bulkCount )
+	{
+		src[ i ] = -( i + 1 );
+
+		i += 1;
+	}
+
+	/* get every run that goes to the end of the list. it should only work if
+	   the whole run is ints. */
+	allInts = 1;
+	index = count;
+	while ( index >= 1 )
+	{
+		TEST_ERR_IF( trotListGetKind( program, l, index, &kind ) != TROT_RC_SUCCESS );
+		if ( kind != TROT_KIND_INT )
+		{
+			allInts = 0;
+		}
+
+		if ( allInts )
+		{
+			TEST_ERR_IF( trotListGetInts( program, l, index, count - index + 1, dst ) != TROT_RC_SUCCESS );
+
+			i = 0;
+			while ( i < count - index + 1 )
+			{
+				TEST_ERR_IF( dst[ i ] != index + i );
+
+				i += 1;
+			}
+		}
+		else
+		{
+			TEST_ERR_IF( trotListGetInts( program, l, index, count - index + 1, dst ) != TROT_RC_ERROR_WRONG_KIND );
+		}
+
+		TEST_ERR_IF( trotListGetInts( program, l, index, 0, dst ) != TROT_RC_SUCCESS );
+
+		index -= 1;
+	}
+
+	TEST_ERR_IF( trotListGetInts( program, l, 0, 1, dst ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListGetInts( program, l, 1, count + 1, dst ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListGetInts( program, l, -( count + 1 ), 1, dst ) != TROT_RC_ERROR_BAD_INDEX );
+
+	/* insert at every index, alternating positive and negative indices */
+	index = 1;
+	while ( index <= count + 1 )
+	{
+		if ( index % 2 == 0 )
+		{
+			TEST_ERR_IF( trotListInsertInts( program, l, INDEX_TO_NEGATIVE_VERSION_INSERT( index, count ), src, bulkCount ) != TROT_RC_SUCCESS );
+		}
+		else
+		{
+			TEST_ERR_IF( trotListInsertInts( program, l, index, src, bulkCount ) != TROT_RC_SUCCESS );
+		}
+
+		TEST_ERR_IF( checkList( program, l ) != 0 );
+
+		TEST_ERR_IF( trotListGetCount( program, l, &countAfter ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( countAfter != count + bulkCount );
+
+		TEST_ERR_IF( trotListGetInts( program, l, index, bulkCount, dst ) != TROT_RC_SUCCESS );
+
+		i = 0;
+		while ( i < count + bulkCount )
+		{
+			if ( i < index - 1 )
+			{
+				TEST_ERR_IF( check( program, l, i + 1, i + 1 ) != 0 );
+			}
+			else if ( i < index - 1 + bulkCount )
+			{
+				TEST_ERR_IF( dst[ i - index + 1 ] != src[ i - index + 1 ] );
+			}
+			else
+			{
+				TEST_ERR_IF( check( program, l, i + 1, i + 1 - bulkCount ) != 0 );
+			}
+
+			i += 1;
+		}
+
+		/* take them back out */
+		i = 0;
+		while ( i < bulkCount )
+		{
+			TEST_ERR_IF( trotListRemove( program, l, index ) != TROT_RC_SUCCESS );
+
+			i += 1;
+		}
+
+		TEST_ERR_IF( checkList( program, l ) != 0 );
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( trotListInsertInts( program, l, 0, src, bulkCount ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListInsertInts( program, l, count + 2, src, bulkCount ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListInsertInts( program, l, 1, src, 0 ) != TROT_RC_SUCCESS );
+
+	/* append, a few at a time so we partly fill the last node */
+	i = 0;
+	while ( i < bulkCount )
+	{
+		TEST_ERR_IF( trotListAppendInts( program, l, &( src[ i ] ), ( bulkCount - i < 3 ) ? bulkCount - i : 3 ) != TROT_RC_SUCCESS );
+
+		i += 3;
+	}
+
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+
+	TEST_ERR_IF( trotListGetCount( program, l, &countAfter ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( countAfter != count + bulkCount );
+
+	TEST_ERR_IF( trotListGetInts( program, l, -bulkCount, bulkCount, dst ) != TROT_RC_SUCCESS );
+
+	i = 0;
+	while ( i < bulkCount )
+	{
+		TEST_ERR_IF( dst[ i ] != src[ i ] );
+
+		i += 1;
+	}
+
+	index = 1;
+	while ( index <= count )
+	{
+		TEST_ERR_IF( check( program, l, index, index ) != 0 );
+
+		index += 1;
+	}
+
+
+	/* CLEANUP */
+	cleanup:
+
+	if ( rc != 0 )
+	{
+		printf( "\x1b[31;1mFAILED AT %d index:%d\n\x1b[0m", rc, index );
+	}
+
+	TROT_FREE( src, bulkCount );
+	TROT_FREE( dst, count + bulkCount );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int testRanges( TrotProgram *program, TrotList *l )
+{
+	/* DATA */
+	int rc = 0;
+
+	TROT_INT count = 0;
+	TROT_INT countAfter = 0;
+
+	TrotList *lCopy = NULL;
+	TrotList *lSlice = NULL;
+	TrotList *lEmpty = NULL;
+
+	TROT_INT start = 0;
+	TROT_INT end = 0;
+	TROT_INT span = 0;
+	TROT_INT ends[ 4 ];
+	int e = 0;
+
+
+	/* CODE */
+	TEST_ERR_IF( trotListGetCount( program, l, &count ) != TROT_RC_SUCCESS );
+
+	TEST_ERR_IF( trotListInit( program, &lEmpty ) != TROT_RC_SUCCESS );
+
+	/* bad ranges */
+	TEST_ERR_IF( trotListSlice( program, l, 0, count, &lSlice ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListSlice( program, l, 1, count + 1, &lSlice ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListRemoveRange( program, l, 0, count ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListRemoveRange( program, l, 1, count + 1 ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListReplaceRange( program, l, 0, count, lEmpty ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListReplaceRange( program, l, 1, count + 1, lEmpty ) != TROT_RC_ERROR_BAD_INDEX );
+	if ( count > 1 )
+	{
+		TEST_ERR_IF( trotListSlice( program, l, 2, 1, &lSlice ) != TROT_RC_ERROR_BAD_INDEX );
+		TEST_ERR_IF( trotListRemoveRange( program, l, -1, -2 ) != TROT_RC_ERROR_BAD_INDEX );
+		TEST_ERR_IF( trotListReplaceRange( program, l, 2, 1, lEmpty ) != TROT_RC_ERROR_BAD_INDEX );
+	}
+
+	start = 1;
+	while ( start <= count )
+	{
+		/* a few different lengths, including ones that span nodes */
+		ends[ 0 ] = start;
+		ends[ 1 ] = start + 1;
+		ends[ 2 ] = start + TROT_NODE_SIZE;
+		ends[ 3 ] = count;
+
+		for ( e = 0; e < 4; e += 1 )
+		{
+			end = ends[ e ];
+			if ( end > count )
+			{
+				continue;
+			}
+
+			span = end - start + 1;
+
+			/* slice, with negative indices every other time */
+			if ( e % 2 == 0 )
+			{
+				TEST_ERR_IF( trotListSlice( program, l, start, end, &lSlice ) != TROT_RC_SUCCESS );
+			}
+			else
+			{
+				TEST_ERR_IF( trotListSlice( program, l, INDEX_TO_NEGATIVE_VERSION_GET_OR_REMOVE( start, count ), INDEX_TO_NEGATIVE_VERSION_GET_OR_REMOVE( end, count ), &lSlice ) != TROT_RC_SUCCESS );
+			}
+
+			TEST_ERR_IF( checkList( program, lSlice ) != 0 );
+			TEST_ERR_IF( checkRange( program, lSlice, 1, span, start ) != 0 );
+
+			/* remove */
+			TEST_ERR_IF( trotListSlice( program, l, 1, -1, &lCopy ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( trotListRemoveRange( program, lCopy, start, end ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( checkList( program, lCopy ) != 0 );
+
+			TEST_ERR_IF( trotListGetCount( program, lCopy, &countAfter ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( countAfter != count - span );
+			TEST_ERR_IF( checkRange( program, lCopy, 1, start - 1, 1 ) != 0 );
+			TEST_ERR_IF( checkRange( program, lCopy, start, count - end, end + 1 ) != 0 );
+
+			/* replace with empty list is the same as remove */
+			trotListFree( program, &lCopy );
+			TEST_ERR_IF( trotListSlice( program, l, 1, -1, &lCopy ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( trotListReplaceRange( program, lCopy, start, end, lEmpty ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( checkList( program, lCopy ) != 0 );
+
+			TEST_ERR_IF( trotListGetCount( program, lCopy, &countAfter ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( countAfter != count - span );
+			TEST_ERR_IF( checkRange( program, lCopy, 1, start - 1, 1 ) != 0 );
+			TEST_ERR_IF( checkRange( program, lCopy, start, count - end, end + 1 ) != 0 );
+
+			/* replace with our slice gives back what we started with */
+			trotListFree( program, &lCopy );
+			TEST_ERR_IF( trotListSlice( program, l, 1, -1, &lCopy ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( trotListReplaceRange( program, lCopy, start, end, lSlice ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( checkList( program, lCopy ) != 0 );
+
+			TEST_ERR_IF( trotListGetCount( program, lCopy, &countAfter ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( countAfter != count );
+			TEST_ERR_IF( checkRange( program, lCopy, 1, count, 1 ) != 0 );
+
+			/* replace with ourself */
+			TEST_ERR_IF( trotListReplaceRange( program, lCopy, start, end, lCopy ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( checkList( program, lCopy ) != 0 );
+
+			TEST_ERR_IF( trotListGetCount( program, lCopy, &countAfter ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( countAfter != ( count * 2 ) - span );
+			TEST_ERR_IF( checkRange( program, lCopy, 1, start - 1, 1 ) != 0 );
+			TEST_ERR_IF( checkRange( program, lCopy, start, count, 1 ) != 0 );
+			TEST_ERR_IF( checkRange( program, lCopy, start + count, count - end, end + 1 ) != 0 );
+
+			trotListFree( program, &lCopy );
+			trotListFree( program, &lSlice );
+		}
+
+		start += 1;
+	}
+
+	/* original list should be untouched */
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, count, 1 ) != 0 );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	if ( rc != 0 )
+	{
+		printf( "\x1b[31;1mFAILED AT %d start:%d end:%d\n\x1b[0m", rc, start, end );
+	}
+
+	trotListFree( program, &lCopy );
+	trotListFree( program, &lSlice );
+	trotListFree( program, &lEmpty );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int checkRange( TrotProgram *program, TrotList *l, TROT_INT index, TROT_INT count, TROT_INT firstValue )
+{
+	/* DATA */
+	int rc = 0;
+
+	TROT_INT i = 0;
+
+
+	/* CODE */
+	while ( i < count )
+	{
+		TEST_ERR_IF( check( program, l, index + i, firstValue + i ) != 0 );
+
+		i += 1;
+	}
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+static int testConcatAndSplit( TrotProgram *program, TrotList *l )
+{
+	/* DATA */
+	int rc = 0;
+
+	TROT_INT count = 0;
+	TROT_INT countAfter = 0;
+
+	TrotList *lCopy = NULL;
+	TrotList *lRest = NULL;
+
+	TROT_INT index = 0;
+
+
+	/* CODE */
+	TEST_ERR_IF( trotListGetCount( program, l, &count ) != TROT_RC_SUCCESS );
+
+	TEST_ERR_IF( trotListSplitAt( program, l, count + 1, &lRest ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListSplitAt( program, l, -( count + 2 ), &lRest ) != TROT_RC_ERROR_BAD_INDEX );
+	TEST_ERR_IF( trotListConcat( program, l, l ) != TROT_RC_ERROR_PRECOND );
+
+	index = 0;
+	while ( index <= count )
+	{
+		/* copy */
+		TEST_ERR_IF( trotListInit( program, &lCopy ) != TROT_RC_SUCCESS );
+		if ( count > 0 )
+		{
+			TEST_ERR_IF( trotListSlice( program, l, 1, -1, &lRest ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( trotListConcat( program, lCopy, lRest ) != TROT_RC_SUCCESS );
+			trotListFree( program, &lRest );
+		}
+
+		/* split, with negative indices every other time */
+		if ( index % 2 == 0 )
+		{
+			TEST_ERR_IF( trotListSplitAt( program, lCopy, index, &lRest ) != TROT_RC_SUCCESS );
+		}
+		else
+		{
+			TEST_ERR_IF( trotListSplitAt( program, lCopy, -( count - index + 1 ), &lRest ) != TROT_RC_SUCCESS );
+		}
+
+		TEST_ERR_IF( checkList( program, lCopy ) != 0 );
+		TEST_ERR_IF( checkList( program, lRest ) != 0 );
+
+		TEST_ERR_IF( trotListGetCount( program, lCopy, &countAfter ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( countAfter != index );
+		TEST_ERR_IF( trotListGetCount( program, lRest, &countAfter ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( countAfter != count - index );
+
+		TEST_ERR_IF( checkRange( program, lCopy, 1, index, 1 ) != 0 );
+		TEST_ERR_IF( checkRange( program, lRest, 1, count - index, index + 1 ) != 0 );
+
+		/* and put it back together */
+		TEST_ERR_IF( trotListConcat( program, lCopy, lRest ) != TROT_RC_SUCCESS );
+
+		TEST_ERR_IF( checkList( program, lCopy ) != 0 );
+		TEST_ERR_IF( checkList( program, lRest ) != 0 );
+
+		TEST_ERR_IF( trotListGetCount( program, lCopy, &countAfter ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( countAfter != count );
+		TEST_ERR_IF( trotListGetCount( program, lRest, &countAfter ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( countAfter != 0 );
+
+		TEST_ERR_IF( checkRange( program, lCopy, 1, count, 1 ) != 0 );
+
+		/* concat onto an empty list */
+		TEST_ERR_IF( trotListConcat( program, lRest, lCopy ) != TROT_RC_SUCCESS );
+
+		TEST_ERR_IF( checkList( program, lCopy ) != 0 );
+		TEST_ERR_IF( checkList( program, lRest ) != 0 );
+		TEST_ERR_IF( checkRange( program, lRest, 1, count, 1 ) != 0 );
+
+		trotListFree( program, &lCopy );
+		trotListFree( program, &lRest );
+
+		index += 1;
+	}
+
+	/* original list should be untouched */
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, count, 1 ) != 0 );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	if ( rc != 0 )
+	{
+		printf( "\x1b[31;1mFAILED AT %d index:%d\n\x1b[0m", rc, index );
+	}
+
+	trotListFree( program, &lCopy );
+	trotListFree( program, &lRest );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int testConcatSizes( TrotProgram *program )
+{
+	/* DATA */
+	int rc = 0;
+
+	TROT_INT sizes[] = { 0, 1, 2, TROT_NODE_SIZE + 1, ( TROT_INDEX_SIZE * TROT_INDEX_SIZE ) + 3, ( TROT_INDEX_SIZE * TROT_INDEX_SIZE * TROT_INDEX_SIZE ) + 5 };
+	int sizesCount = sizeof( sizes ) / sizeof( sizes[ 0 ] );
+
+	int a = 0;
+	int b = 0;
+
+	TrotList *lA = NULL;
+	TrotList *lB = NULL;
+
+	TROT_INT countAfter = 0;
+	TROT_INT index = 0;
+
+
+	/* CODE */
+	for ( a = 0; a < sizesCount; a += 1 )
+	{
+		for ( b = 0; b < sizesCount; b += 1 )
+		{
+			/* alternating kinds gives us a node per item, and so a tall index */
+			TEST_ERR_IF( createIntListAlternating( program, &lA, sizes[ a ] ) != 0 );
+			TEST_ERR_IF( createListIntAlternating( program, &lB, sizes[ b ] ) != 0 );
+
+			TEST_ERR_IF( trotListConcat( program, lA, lB ) != TROT_RC_SUCCESS );
+
+			TEST_ERR_IF( checkList( program, lA ) != 0 );
+			TEST_ERR_IF( checkList( program, lB ) != 0 );
+
+			TEST_ERR_IF( trotListGetCount( program, lA, &countAfter ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( countAfter != sizes[ a ] + sizes[ b ] );
+
+			TEST_ERR_IF( checkRange( program, lA, 1, sizes[ a ], 1 ) != 0 );
+			TEST_ERR_IF( checkRange( program, lA, sizes[ a ] + 1, sizes[ b ], 1 ) != 0 );
+
+			/* and split it back apart */
+			trotListFree( program, &lB );
+			TEST_ERR_IF( trotListSplitAt( program, lA, sizes[ a ], &lB ) != TROT_RC_SUCCESS );
+
+			TEST_ERR_IF( checkList( program, lA ) != 0 );
+			TEST_ERR_IF( checkList( program, lB ) != 0 );
+
+			TEST_ERR_IF( checkRange( program, lA, 1, sizes[ a ], 1 ) != 0 );
+			TEST_ERR_IF( checkRange( program, lB, 1, sizes[ b ], 1 ) != 0 );
+
+			trotListFree( program, &lA );
+			trotListFree( program, &lB );
+		}
+	}
+
+	/* split a big list everywhere */
+	index = 0;
+	while ( index <= sizes[ sizesCount - 1 ] )
+	{
+		TEST_ERR_IF( createIntListAlternating( program, &lA, sizes[ sizesCount - 1 ] ) != 0 );
+
+		TEST_ERR_IF( trotListSplitAt( program, lA, index, &lB ) != TROT_RC_SUCCESS );
+
+		TEST_ERR_IF( checkList( program, lA ) != 0 );
+		TEST_ERR_IF( checkList( program, lB ) != 0 );
+
+		TEST_ERR_IF( checkRange( program, lA, 1, index, 1 ) != 0 );
+		TEST_ERR_IF( checkRange( program, lB, 1, sizes[ sizesCount - 1 ] - index, index + 1 ) != 0 );
+
+		/* concat the halves the other way around */
+		TEST_ERR_IF( trotListConcat( program, lB, lA ) != TROT_RC_SUCCESS );
+
+		TEST_ERR_IF( checkList( program, lB ) != 0 );
+
+		TEST_ERR_IF( checkRange( program, lB, 1, sizes[ sizesCount - 1 ] - index, index + 1 ) != 0 );
+		TEST_ERR_IF( checkRange( program, lB, sizes[ sizesCount - 1 ] - index + 1, index, 1 ) != 0 );
+
+		trotListFree( program, &lA );
+		trotListFree( program, &lB );
+
+		index += 7;
+	}
+
+
+	/* CLEANUP */
+	cleanup:
+
+	if ( rc != 0 )
+	{
+		printf( "\x1b[31;1mFAILED AT %d a:%d b:%d index:%d\n\x1b[0m", rc, a, b, index );
+	}
+
+	trotListFree( program, &lA );
+	trotListFree( program, &lB );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int testCompact( TrotProgram *program )
+{
+	/* DATA */
+	int rc = 0;
+
+	TrotList *l = NULL;
+
+	TROT_INT ints[ TROT_NODE_SIZE * 3 ];
+	TROT_INT keep = TROT_NODE_UNDERFLOW - 1;
+
+	TROT_INT memBefore = 0;
+	TROT_INT memAfter = 0;
+
+	TROT_INT index = 0;
+	TROT_INT n = 0;
+	TROT_INT width = 0;
+
+
+	/* CODE */
+	index = 0;
+	while ( index < TROT_NODE_SIZE * 3 )
+	{
+		ints[ index ] = index + 1;
+
+		index += 1;
+	}
+
+	/* inserting into a full node splits it, and removing what we inserted
+	   leaves it split */
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInts( program, l, ints, TROT_NODE_SIZE * 3 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( countNodes( l ) != 3 );
+
+	index = 2;
+	while ( index <= TROT_NODE_SIZE * 3 )
+	{
+		TEST_ERR_IF( trotListInsertInt( program, l, index, 0 ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( trotListRemoveInt( program, l, index, &n ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( n != 0 );
+
+		index += TROT_NODE_SIZE;
+	}
+
+	TEST_ERR_IF( countNodes( l ) != 6 );
+
+	/* compact should put them back into 3 nodes */
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memBefore ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListCompact( program, l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memAfter ) != TROT_RC_SUCCESS );
+
+	TEST_ERR_IF( countNodes( l ) != 3 );
+	TEST_ERR_IF( memAfter >= memBefore );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, TROT_NODE_SIZE * 3, 1 ) != 0 );
+
+	trotListFree( program, &l );
+
+	/* nodes that get too empty should merge with their neighbours */
+	if ( keep > 0 )
+	{
+		TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( trotListAppendInts( program, l, ints, TROT_NODE_SIZE * 3 ) != TROT_RC_SUCCESS );
+
+		/* first node's neighbour is full, so it can't merge */
+		TEST_ERR_IF( trotListRemoveRange( program, l, keep + 1, TROT_NODE_SIZE ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( countNodes( l ) != 3 );
+
+		/* but now second node can merge into first node */
+		width = l->laPointsTo->headNode.next->next->width;
+		TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memBefore ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( trotListRemoveRange( program, l, ( keep * 2 ) + 1, keep + TROT_NODE_SIZE ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memAfter ) != TROT_RC_SUCCESS );
+
+		TEST_ERR_IF( countNodes( l ) != 2 );
+		TEST_ERR_IF( memBefore - memAfter != (TROT_INT)( sizeof( TrotListNode ) + ( width * TROT_NODE_SIZE ) ) );
+		TEST_ERR_IF( checkList( program, l ) != 0 );
+		TEST_ERR_IF( checkRange( program, l, 1, keep, 1 ) != 0 );
+		TEST_ERR_IF( checkRange( program, l, keep + 1, keep, TROT_NODE_SIZE + 1 ) != 0 );
+		TEST_ERR_IF( checkRange( program, l, ( keep * 2 ) + 1, TROT_NODE_SIZE, ( TROT_NODE_SIZE * 2 ) + 1 ) != 0 );
+
+		/* and removing one at a time from the last node merges too */
+		while ( countNodes( l ) != 1 )
+		{
+			TEST_ERR_IF( trotListRemove( program, l, -1 ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( checkList( program, l ) != 0 );
+		}
+
+		TEST_ERR_IF( checkRange( program, l, 1, keep, 1 ) != 0 );
+		TEST_ERR_IF( checkRange( program, l, keep + 1, keep, TROT_NODE_SIZE + 1 ) != 0 );
+
+		trotListFree( program, &l );
+	}
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &l );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int testMixedNodes( TrotProgram *program )
+{
+	/* DATA */
+	int rc = 0;
+
+	TrotList *l = NULL;
+	TrotList *l2 = NULL;
+	TrotList *lSub = NULL;
+
+	TROT_INT ints[ 2 ];
+
+	TROT_INT index = 0;
+	TROT_INT n = 0;
+	TROT_INT kind = 0;
+
+
+	/* CODE */
+	/* alternating kinds should pack into full mixed nodes */
+	TEST_ERR_IF( createIntListAlternating( program, &l, MAGIC_NUMBER ) != 0 );
+	TEST_ERR_IF( countNodes( l ) != MAGIC_NUMBER / TROT_NODE_SIZE );
+	TEST_ERR_IF( l->laPointsTo->headNode.next->kind != NODE_KIND_MIXED );
+
+	/* inserting into a full mixed node splits it */
+	TEST_ERR_IF( trotListInsertInt( program, l, 2, 0 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( addListWithValue( program, l, 3, 0 ) != 0 );
+	TEST_ERR_IF( countNodes( l ) != ( MAGIC_NUMBER / TROT_NODE_SIZE ) + 1 );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+
+	TEST_ERR_IF( trotListGetKind( program, l, 2, &kind ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( kind != TROT_KIND_INT );
+	TEST_ERR_IF( trotListGetKind( program, l, 3, &kind ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( kind != TROT_KIND_LIST );
+	TEST_ERR_IF( trotListGetInt( program, l, 3, &n ) != TROT_RC_ERROR_WRONG_KIND );
+	TEST_ERR_IF( trotListGetList( program, l, 2, &lSub ) != TROT_RC_ERROR_WRONG_KIND );
+
+	TEST_ERR_IF( trotListRemoveList( program, l, 2, &lSub ) != TROT_RC_ERROR_WRONG_KIND );
+	TEST_ERR_IF( trotListRemoveInt( program, l, 2, &n ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( n != 0 );
+	TEST_ERR_IF( trotListRemoveInt( program, l, 2, &n ) != TROT_RC_ERROR_WRONG_KIND );
+	TEST_ERR_IF( trotListRemoveList( program, l, 2, &lSub ) != TROT_RC_SUCCESS );
+	trotListFree( program, &lSub );
+
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, MAGIC_NUMBER, 1 ) != 0 );
+
+	/* replacing swaps kinds in place */
+	index = 1;
+	while ( index <= MAGIC_NUMBER )
+	{
+		if ( index % 2 == 1 )
+		{
+			TEST_ERR_IF( trotListInit( program, &lSub ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( trotListAppendInt( program, lSub, index ) != TROT_RC_SUCCESS );
+			TEST_ERR_IF( trotListReplaceWithList( program, l, index, lSub ) != TROT_RC_SUCCESS );
+			trotListFree( program, &lSub );
+		}
+		else
+		{
+			TEST_ERR_IF( trotListReplaceWithInt( program, l, index, index ) != TROT_RC_SUCCESS );
+		}
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( countNodes( l ) != ( MAGIC_NUMBER / TROT_NODE_SIZE ) + 1 );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, MAGIC_NUMBER, 1 ) != 0 );
+
+	/* getting ints stops at the first list */
+	TEST_ERR_IF( trotListGetInts( program, l, 2, 1, ints ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( ints[ 0 ] != 2 );
+	TEST_ERR_IF( trotListGetInts( program, l, 2, 2, ints ) != TROT_RC_ERROR_WRONG_KIND );
+
+	/* slices stay packed, and compact packs the split nodes back together */
+	TEST_ERR_IF( trotListSlice( program, l, 1, -1, &l2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( countNodes( l2 ) != MAGIC_NUMBER / TROT_NODE_SIZE );
+	TEST_ERR_IF( checkList( program, l2 ) != 0 );
+	TEST_ERR_IF( checkRange( program, l2, 1, MAGIC_NUMBER, 1 ) != 0 );
+	trotListFree( program, &l2 );
+
+	TEST_ERR_IF( trotListCompact( program, l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( countNodes( l ) != MAGIC_NUMBER / TROT_NODE_SIZE );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, MAGIC_NUMBER, 1 ) != 0 );
+
+	/* removing everything one at a time, from the middle */
+	while ( countNodes( l ) != 0 )
+	{
+		TEST_ERR_IF( trotListGetCount( program, l, &n ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( trotListRemove( program, l, ( n / 2 ) + 1 ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( checkList( program, l ) != 0 );
+	}
+
+	trotListFree( program, &l );
+
+	/* a small node of the other kind becomes mixed instead of adding a node */
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInt( program, l, 1 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( addListWithValue( program, l, 2, 2 ) != 0 );
+	TEST_ERR_IF( trotListInsertInt( program, l, 2, 0 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( addListWithValue( program, l, 1, 0 ) != 0 );
+	TEST_ERR_IF( countNodes( l ) != 1 );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( check( program, l, 1, 0 ) != 0 );
+	TEST_ERR_IF( check( program, l, 2, 1 ) != 0 );
+	TEST_ERR_IF( check( program, l, 3, 0 ) != 0 );
+	TEST_ERR_IF( check( program, l, 4, 2 ) != 0 );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &l );
+	trotListFree( program, &l2 );
+	trotListFree( program, &lSub );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int testInlineNode( TrotProgram *program )
+{
+	/* DATA */
+	int rc = 0;
+
+	TrotList *l = NULL;
+	TrotList *l2 = NULL;
+	TrotList *l3 = NULL;
+
+	TrotListActual *la = NULL;
+
+	TROT_INT memUsed = 0;
+	TROT_INT capacity = 0;
+	TROT_INT count = 0;
+
+
+	/* CODE */
+	/* small lists keep their items in the list itself */
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+	la = l->laPointsTo;
+	memUsed = program->memoryUsed;
+
+	TEST_ERR_IF( addListWithValue( program, l, 1, 1 ) != 0 );
+	TEST_ERR_IF( la->headNode.next != &( la->inlineNode ) );
+	capacity = la->inlineNode.capacity;
+	TEST_ERR_IF( capacity < 1 );
+
+	count = 1;
+	while ( count < capacity )
+	{
+		count += 1;
+		TEST_ERR_IF( addListWithValue( program, l, count, count ) != 0 );
+	}
+
+	TEST_ERR_IF( la->headNode.next != &( la->inlineNode ) );
+	TEST_ERR_IF( countNodes( l ) != 1 );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+
+	/* growing past it moves the items into a normal node, if that's bigger */
+	count += 1;
+	TEST_ERR_IF( addListWithValue( program, l, count, count ) != 0 );
+	if ( capacity < TROT_NODE_SIZE )
+	{
+		TEST_ERR_IF( countNodes( l ) != 1 );
+		TEST_ERR_IF( la->headNode.next == &( la->inlineNode ) );
+	}
+	else
+	{
+		TEST_ERR_IF( countNodes( l ) != 2 );
+		TEST_ERR_IF( la->headNode.next != &( la->inlineNode ) );
+	}
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, count, 1 ) != 0 );
+
+	/* and it's used again once the list is empty */
+	TEST_ERR_IF( trotListRemoveRange( program, l, 1, -1 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( program->memoryUsed != memUsed );
+	TEST_ERR_IF( addListWithValue( program, l, 1, 1 ) != 0 );
+	TEST_ERR_IF( trotListAppendInt( program, l, 2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( la->headNode.next != &( la->inlineNode ) );
+	TEST_ERR_IF( la->inlineNode.kind != NODE_KIND_MIXED );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, 2, 1 ) != 0 );
+
+	/* concat into a list that's using its inline node */
+	TEST_ERR_IF( trotListInit( program, &l2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInt( program, l2, 3 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( addListWithValue( program, l2, 2, 4 ) != 0 );
+	TEST_ERR_IF( trotListConcat( program, l, l2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( countNodes( l ) != 2 );
+	TEST_ERR_IF( countNodes( l2 ) != 0 );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkList( program, l2 ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, 4, 1 ) != 0 );
+
+	/* concat into an empty list takes over the inline node */
+	TEST_ERR_IF( trotListInit( program, &l3 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListConcat( program, l3, l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( l3->laPointsTo->headNode.next != &( l3->laPointsTo->inlineNode ) );
+	TEST_ERR_IF( la->inlineNode.kind != 0 );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkList( program, l3 ) != 0 );
+	TEST_ERR_IF( checkRange( program, l3, 1, 4, 1 ) != 0 );
+
+	/* and so does splitting */
+	trotListFree( program, &l2 );
+	TEST_ERR_IF( trotListSplitAt( program, l3, 0, &l2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( l2->laPointsTo->headNode.next != &( l2->laPointsTo->inlineNode ) );
+	TEST_ERR_IF( checkList( program, l2 ) != 0 );
+	TEST_ERR_IF( checkList( program, l3 ) != 0 );
+	TEST_ERR_IF( checkRange( program, l2, 1, 4, 1 ) != 0 );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &l );
+	trotListFree( program, &l2 );
+	trotListFree( program, &l3 );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int testNodeGrowth( TrotProgram *program )
+{
+	/* DATA */
+	int rc = 0;
+
+	TrotList *l = NULL;
+
+	TROT_INT total = TROT_NODE_SIZE * TROT_NODE_GROWTH * 4;
+
+	TROT_INT memStart = 0;
+	TROT_INT memBefore = 0;
+	TROT_INT memAfter = 0;
+
+	TROT_INT index = 0;
+
+	TrotListNode *node = NULL;
+
+
+	/* CODE */
+	if ( TROT_NODE_SIZE_MAX <= TROT_NODE_SIZE || TROT_MAX_CHILDREN < total )
+	{
+		printf( "--- SKIPPING NODE GROWTH TEST! ---\n" );
+		return 0;
+	}
+
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memStart ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+
+	/* small lists keep small nodes */
+	index = 1;
+	while ( index <= TROT_NODE_SIZE * TROT_NODE_GROWTH )
+	{
+		TEST_ERR_IF( trotListAppendInt( program, l, index ) != TROT_RC_SUCCESS );
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( biggestNode( l ) != TROT_NODE_SIZE );
+
+	/* once the list is big, new nodes get bigger */
+	while ( index <= total )
+	{
+		TEST_ERR_IF( trotListAppendInt( program, l, index ) != TROT_RC_SUCCESS );
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( biggestNode( l ) <= TROT_NODE_SIZE );
+	TEST_ERR_IF( biggestNode( l ) > TROT_NODE_SIZE_MAX );
+	TEST_ERR_IF( countNodes( l ) >= total / TROT_NODE_SIZE );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, total, 1 ) != 0 );
+
+	/* after most of it is removed, compact shrinks the big nodes */
+	TEST_ERR_IF( trotListRemoveRange( program, l, 1, total - TROT_NODE_SIZE ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( biggestNode( l ) <= TROT_NODE_SIZE );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memBefore ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListCompact( program, l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memAfter ) != TROT_RC_SUCCESS );
+
+	TEST_ERR_IF( biggestNode( l ) > TROT_NODE_SIZE );
+	TEST_ERR_IF( memAfter >= memBefore );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, TROT_NODE_SIZE, total - TROT_NODE_SIZE + 1 ) != 0 );
+
+	trotListFree( program, &l );
+
+	/* after the list shrinks, new nodes are small again, so splitting a
+	   full big node must still leave room in both halves */
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+
+	index = 1;
+	while ( index <= total )
+	{
+		TEST_ERR_IF( trotListAppendInt( program, l, index ) != TROT_RC_SUCCESS );
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( trotListRemoveRange( program, l, 1, total - ( TROT_NODE_SIZE * TROT_NODE_GROWTH / 2 ) ) != TROT_RC_SUCCESS );
+
+	/* find a big node */
+	index = 0;
+	node = l->laPointsTo->headNode.next;
+	while ( node->capacity <= TROT_NODE_SIZE )
+	{
+		index += node->count;
+		node = node->next;
+
+		TEST_ERR_IF( node == &( l->laPointsTo->headNode ) );
+	}
+
+	/* fill it, then insert into its back half */
+	while ( node->count < node->capacity )
+	{
+		TEST_ERR_IF( trotListInsertInt( program, l, index + node->count, 0 ) != TROT_RC_SUCCESS );
+	}
+
+	TEST_ERR_IF( trotListInsertInt( program, l, index + node->count, 0 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+
+	trotListFree( program, &l );
+
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memAfter ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memAfter != memStart );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &l );
+
+	return rc;
+}
+
+/******************************************************************************/
+static TROT_INT biggestNode( TrotList *l )
+{
+	/* DATA */
+	TROT_INT biggest = 0;
+
+	TrotListNode *node = NULL;
+
+
+	/* CODE */
+	node = l->laPointsTo->headNode.next;
+	while ( node != &( l->laPointsTo->headNode ) )
+	{
+		if ( node->capacity > biggest )
+		{
+			biggest = node->capacity;
+		}
+
+		node = node->next;
+	}
+
+	return biggest;
+}
+
+/******************************************************************************/
+static int testIntWidths( TrotProgram *program )
+{
+	/* DATA */
+	int rc = 0;
+
+	TrotList *l = NULL;
+	TrotList *l2 = NULL;
+
+	TROT_INT ints[ TROT_NODE_SIZE * 3 ];
+	TROT_INT got[ TROT_NODE_SIZE * 3 ];
+
+	TROT_INT memBefore = 0;
+	TROT_INT memSmall = 0;
+	TROT_INT memBig = 0;
+
+	TROT_INT index = 0;
+	TROT_INT n = 0;
+
+
+	/* CODE */
+	/* lists of small ints use narrow nodes */
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memBefore ) != TROT_RC_SUCCESS );
+
+	index = 1;
+	while ( index <= TROT_NODE_SIZE * 3 )
+	{
+		TEST_ERR_IF( trotListAppendInt( program, l, index ) != TROT_RC_SUCCESS );
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memSmall ) != TROT_RC_SUCCESS );
+	memSmall -= memBefore;
+
+	TEST_ERR_IF( widestNode( l ) != NODE_WIDTH_8 );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, TROT_NODE_SIZE * 3, 1 ) != 0 );
+
+	/* and take less memory than big ints */
+	TEST_ERR_IF( trotListInit( program, &l2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memBefore ) != TROT_RC_SUCCESS );
+
+	index = 1;
+	while ( index <= TROT_NODE_SIZE * 3 )
+	{
+		TEST_ERR_IF( trotListAppendInt( program, l2, index + 100000 ) != TROT_RC_SUCCESS );
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memBig ) != TROT_RC_SUCCESS );
+	memBig -= memBefore;
+
+	TEST_ERR_IF( widestNode( l2 ) != NODE_WIDTH_FULL );
+	TEST_ERR_IF( memSmall >= memBig );
+
+	trotListFree( program, &l2 );
+
+	/* putting in an int that doesn't fit widens the node */
+	TEST_ERR_IF( trotListReplaceWithInt( program, l, 2, 1000 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( widestNode( l ) != NODE_WIDTH_16 );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( check( program, l, 2, 1000 ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, 1, 1 ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 3, ( TROT_NODE_SIZE * 3 ) - 2, 3 ) != 0 );
+
+	TEST_ERR_IF( trotListInsertInt( program, l, TROT_NODE_SIZE * 3, -5 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( widestNode( l ) != NODE_WIDTH_FULL );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( trotListRemoveInt( program, l, TROT_NODE_SIZE * 3, &n ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( n != -5 );
+
+	TEST_ERR_IF( trotListReplaceWithInt( program, l, 2, 2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, TROT_NODE_SIZE * 3, 1 ) != 0 );
+
+	/* getting a run of ints works whatever width they're stored in */
+	TEST_ERR_IF( trotListGetInts( program, l, 1, TROT_NODE_SIZE * 3, got ) != TROT_RC_SUCCESS );
+	index = 0;
+	while ( index < TROT_NODE_SIZE * 3 )
+	{
+		TEST_ERR_IF( got[ index ] != index + 1 );
+
+		index += 1;
+	}
+
+	trotListFree( program, &l );
+
+	/* the inline node is widened in place */
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInt( program, l, 1 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInt( program, l, 2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( l->laPointsTo->headNode.next != &( l->laPointsTo->inlineNode ) );
+	TEST_ERR_IF( widestNode( l ) != NODE_WIDTH_8 );
+
+	TEST_ERR_IF( trotListAppendInt( program, l, 70000 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( l->laPointsTo->headNode.next != &( l->laPointsTo->inlineNode ) );
+	TEST_ERR_IF( widestNode( l ) != NODE_WIDTH_FULL );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkRange( program, l, 1, 2, 1 ) != 0 );
+	TEST_ERR_IF( check( program, l, 3, 70000 ) != 0 );
+
+	trotListFree( program, &l );
+
+	/* bulk appends pick the width for each node */
+	index = 0;
+	while ( index < TROT_NODE_SIZE * 3 )
+	{
+		ints[ index ] = ( index < TROT_NODE_SIZE ) ? index : ( index * 1000 );
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInts( program, l, ints, TROT_NODE_SIZE * 3 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( trotListGetInts( program, l, 1, TROT_NODE_SIZE * 3, got ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memcmp( ints, got, sizeof( ints ) ) != 0 );
+
+	trotListFree( program, &l );
+
+	/* narrow nodes can't take items from wider nodes, but compact widens
+	   them so they can */
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+
+	index = 1;
+	while ( index <= TROT_NODE_SIZE * 2 )
+	{
+		TEST_ERR_IF( trotListAppendInt( program, l, ( index <= TROT_NODE_SIZE ) ? index : ( index + 100000 ) ) != TROT_RC_SUCCESS );
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( trotListRemoveRange( program, l, 2, TROT_NODE_SIZE ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListRemoveRange( program, l, 2, TROT_NODE_SIZE ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( countNodes( l ) != 2 );
+
+	TEST_ERR_IF( trotListCompact( program, l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( countNodes( l ) != 1 );
+	TEST_ERR_IF( widestNode( l ) != NODE_WIDTH_FULL );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( check( program, l, 1, 1 ) != 0 );
+	TEST_ERR_IF( check( program, l, 2, ( TROT_NODE_SIZE * 2 ) + 100000 ) != 0 );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &l );
+	trotListFree( program, &l2 );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int testRuns( TrotProgram *program )
+{
+	/* DATA */
+	int rc = 0;
+
+	TrotList *l = NULL;
+	TrotList *l2 = NULL;
+
+	TROT_INT expected[ TROT_NODE_SIZE * 20 ];
+	TROT_INT total = TROT_NODE_SIZE * 20;
+
+	TROT_INT memBefore = 0;
+	TROT_INT memAfter = 0;
+
+	TROT_INT index = 0;
+	TROT_INT n = 0;
+
+
+	/* CODE */
+	index = 0;
+	while ( index < total )
+	{
+		expected[ index ] = 0;
+
+		index += 1;
+	}
+
+	/* a fill is one run, however long it is */
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memBefore ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendRun( program, l, 0, total - 2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendRun( program, l, 0, 1 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendRun( program, l, 0, 0 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInt( program, l, 0 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( program, &memAfter ) != TROT_RC_SUCCESS );
+
+	TEST_ERR_IF( countNodes( l ) != 1 );
+	TEST_ERR_IF( memAfter - memBefore != (TROT_INT)( sizeof( TrotListNode ) + sizeof( TROT_INT ) ) );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkInts( program, l, expected, total ) != 0 );
+
+	/* changing an item in the middle splits the run */
+	TEST_ERR_IF( trotListReplaceWithInt( program, l, total / 2, 7 ) != TROT_RC_SUCCESS );
+	expected[ ( total / 2 ) - 1 ] = 7;
+	TEST_ERR_IF( countNodes( l ) != 3 );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkInts( program, l, expected, total ) != 0 );
+
+	/* putting in the same int doesn't */
+	TEST_ERR_IF( trotListReplaceWithInt( program, l, 1, 0 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInsertInt( program, l, 1, 0 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListRemoveInt( program, l, 1, &n ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( n != 0 );
+	TEST_ERR_IF( countNodes( l ) != 3 );
+	TEST_ERR_IF( checkInts( program, l, expected, total ) != 0 );
+
+	/* inserting something else splits it too */
+	TEST_ERR_IF( trotListInsertInt( program, l, 2, 300 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListRemoveInt( program, l, 2, &n ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( n != 300 );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkInts( program, l, expected, total ) != 0 );
+
+	/* and so does putting in a list */
+	TEST_ERR_IF( trotListInit( program, &l2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListReplaceWithList( program, l, -2, l2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( trotListReplaceWithInt( program, l, -2, 0 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkInts( program, l, expected, total ) != 0 );
+	trotListFree( program, &l2 );
+
+	/* slices of runs are runs */
+	TEST_ERR_IF( trotListSlice( program, l, 2, total - 1, &l2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( program, l2 ) != 0 );
+	TEST_ERR_IF( checkInts( program, l2, &( expected[ 1 ] ), total - 2 ) != 0 );
+	TEST_ERR_IF( countNodes( l2 ) > countNodes( l ) );
+	trotListFree( program, &l2 );
+
+	/* removing from runs */
+	TEST_ERR_IF( trotListRemoveRange( program, l, 2, ( total / 2 ) - 2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( checkInts( program, l, &( expected[ ( total / 2 ) - 3 ] ), total - ( total / 2 ) + 3 ) != 0 );
+
+	/* compact joins runs of the same int */
+	TEST_ERR_IF( trotListReplaceWithInt( program, l, 3, 0 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListCompact( program, l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+
+	trotListFree( program, &l );
+
+	/* appending the same int over and over makes a run */
+	TEST_ERR_IF( trotListInit( program, &l ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInt( program, l, 1 ) != TROT_RC_SUCCESS );
+
+	index = 1;
+	while ( index < total )
+	{
+		TEST_ERR_IF( trotListAppendInt( program, l, 5 ) != TROT_RC_SUCCESS );
+
+		index += 1;
+	}
+
+	TEST_ERR_IF( countNodes( l ) > 3 );
+	TEST_ERR_IF( checkList( program, l ) != 0 );
+	TEST_ERR_IF( check( program, l, 1, 1 ) != 0 );
+	TEST_ERR_IF( check( program, l, total, 5 ) != 0 );
+
+	trotListFree( program, &l );
+
+
+	/* CLEANUP */
+	cleanup:
+
+	trotListFree( program, &l );
+	trotListFree( program, &l2 );
+
+	return rc;
+}
+
+/******************************************************************************/
+static int checkInts( TrotProgram *program, TrotList *l, TROT_INT *expected, TROT_INT count )
+{
+	/* DATA */
+	int rc = 0;
+
+	TROT_INT got = 0;
+	TROT_INT index = 0;
+
+
+	/* CODE */
+	TEST_ERR_IF( trotListGetCount( program, l, &got ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( got != count );
+
+	while ( index < count )
+	{
+		TEST_ERR_IF( trotListGetInt( program, l, index + 1, &got ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( got != expected[ index ] );
+
+		index += 1;
+	}
+
+
+	/* CLEANUP */
+	cleanup:
+
+	return rc;
+}
+
+/******************************************************************************/
+static TROT_INT widestNode( TrotList *l )
+{
+	/* DATA */
+	TROT_INT widest = 0;
+
+	TrotListNode *node = NULL;
+
+
+	/* CODE */
+	node = l->laPointsTo->headNode.next;
+	while ( node != &( l->laPointsTo->headNode ) )
+	{
+		if ( node->width > widest )
+		{
+			widest = node->width;
+		}
+
+		node = node->next;
+	}
+
+	return widest;
+}
+
+/******************************************************************************/
+static TROT_INT countNodes( TrotList *l )
+{
+	/* DATA */
+	TROT_INT count = 0;
+
+	TrotListNode *node = NULL;
+
+
+	/* CODE */
+	node = l->laPointsTo->headNode.next;
+	while ( node != &( l->laPointsTo->headNode ) )
+	{
+		count += 1;
+
+		node = node->next;
+	}
+
+	return count;
+}
@@ -39,6 +39,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /******************************************************************************/
 #define MEMORY_MANAGEMENT_REFS_COUNT 10
 
+#define SHARED_REFS_COUNT 1000
+
 #define PRINT_ENCODED_LISTS 0
 
 /******************************************************************************/
@@ -46,33 +48,81 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 static int failOnMallocCount = 0;
 static int currentMallocCount = 0;
 
+/* how many mallocs haven't been freed yet */
+static int outstandingMallocs = 0;
+
 void *trotHookMalloc( size_t size )
 {
+	void *p = NULL;
+
 	currentMallocCount += 1;
 	if ( currentMallocCount == failOnMallocCount )
 	{
 		return NULL;
 	}
 
-	return malloc( size );
+	p = malloc( size );
+	if ( p != NULL )
+	{
+		outstandingMallocs += 1;
+	}
+
+	return p;
 }
 
 void *trotHookCalloc( size_t nmemb, size_t size )
 {
+	void *p = NULL;
+
 	currentMallocCount += 1;
 	if ( currentMallocCount == failOnMallocCount )
 	{
 		return NULL;
 	}
 
-	return calloc( nmemb, size );
+	p = calloc( nmemb, size );
+	if ( p != NULL )
+	{
+		outstandingMallocs += 1;
+	}
+
+	return p;
+}
+
+void *trotHookRealloc( void *ptr, size_t size )
+{
+	currentMallocCount += 1;
+	if ( currentMallocCount == failOnMallocCount )
+	{
+		return NULL;
+	}
+
+	return realloc( ptr, size );
 }
 
 void trotHookFree( void *ptr )
 {
+	if ( ptr != NULL )
+	{
+		outstandingMallocs -= 1;
+	}
+
 	free( ptr );
 }
 
+/******************************************************************************/
+/* an allocator to give to trotProgramLoad, that keeps count of what it does */
+typedef struct
+{
+	int reallocs;
+	int outstanding;
+} CountingAllocator;
+
+static void *countingMalloc( void *context, size_t size );
+static void *countingCalloc( void *context, size_t nmemb, size_t size );
+static void *countingRealloc( void *context, void *p, size_t size );
+static void countingFree( void *context, void *p );
+
 /******************************************************************************/
 static int testMemoryManagement( TrotProgram *program );
 static int testDeepList( TrotProgram *program );
@@ -108,6 +158,29 @@ int testMemory( TrotProgram *program )
 	TrotProgram *testProgram = NULL;
 	TROT_INT testMemLimit = 0;
 
+	TrotList *lSlab = NULL;
+	TrotList *lSlabTwin = NULL;
+	TROT_INT slabs = 0;
+	TROT_INT slabBytes = 0;
+	TROT_INT slabObjects = 0;
+	TROT_INT slabs2 = 0;
+	TROT_INT slabBytes2 = 0;
+	TROT_INT slabObjects2 = 0;
+
+	TrotList *lTeardown = NULL;
+	int mallocsBefore = 0;
+
+	CountingAllocator counting = { 0, 0 };
+	TrotAllocator allocator;
+	TrotList *lChild = NULL;
+	TrotList *lCharacters = NULL;
+	TrotList *lOther = NULL;
+	TROT_INT finished = 0;
+
+	TrotList *lShared[ SHARED_REFS_COUNT ];
+	TrotList *lRef = NULL;
+	TROT_INT refs = 0;
+
 	int j = 0;
 	int flagAtLeastOneFailed = 0;
 	char *spinner = "-\\|/";
@@ -147,10 +220,18 @@ int testMemory( TrotProgram *program )
 				spinnerI += 1;
 				printf( "\r%d: %d of %d %c", i, j, failedFuncs[ i ].numberOfTests - 1, spinner[ spinnerI % 4 ]  ); fflush( stdout );
 
+				/* each try gets its own program, so its slabs start out empty
+				   and the mallocs that refill them can fail */
+				TEST_ERR_IF( ( testProgram = TROT_HOOK_CALLOC( 1, sizeof( *program ) ) ) == NULL );
+				TEST_ERR_IF( trotProgramMemorySetLimit( testProgram, TROT_INT_MAX ) != TROT_RC_SUCCESS );
+
 				currentMallocCount = 0;
 				failOnMallocCount += 1;
 
-				rc = failedFuncs[ i ].func( program, j );
+				rc = failedFuncs[ i ].func( testProgram, j );
+
+				TEST_ERR_IF( testProgram->memoryUsed != 0 );
+				trotProgramFree( &testProgram );
 
 				if ( rc == TROT_RC_ERROR_MEMORY_ALLOCATION_FAILED )
 				{
@@ -262,7 +343,7 @@ int testMemory( TrotProgram *program )
 		i += 1;
 	}
 
-	TROT_HOOK_FREE( testProgram );
+	trotProgramFree( &testProgram );
 
 	/* **************************************** */
 	/* test that calloc sets pointers to NULL */
@@ -272,6 +353,128 @@ int testMemory( TrotProgram *program )
 	TEST_ERR_IF( iArray[ 5 ] != NULL );
 	TROT_FREE( iArray, 10 );
 
+	/* **************************************** */
+	/* test that small objects come from slabs and get reused */
+	printf( "  Testing slabs...\n" ); fflush( stdout );
+	TEST_ERR_IF( ( testProgram = TROT_HOOK_CALLOC( 1, sizeof( *program ) ) ) == NULL );
+	TEST_ERR_IF( trotProgramMemorySetLimit( testProgram, TROT_INT_MAX ) != TROT_RC_SUCCESS );
+
+	TEST_ERR_IF( trotProgramMemoryGetSlabStats( testProgram, &slabs, &slabBytes, &slabObjects ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( slabs != 0 );
+	TEST_ERR_IF( slabBytes != 0 );
+	TEST_ERR_IF( slabObjects != 0 );
+
+	TEST_ERR_IF( trotListInit( testProgram, &lSlab ) != TROT_RC_SUCCESS );
+
+	TEST_ERR_IF( trotProgramMemoryGetUsed( testProgram, &memUsed ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetSlabStats( testProgram, &slabs, &slabBytes, &slabObjects ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( slabs == 0 );
+	TEST_ERR_IF( slabBytes < memUsed );
+	TEST_ERR_IF( slabObjects == 0 );
+
+	i = 0;
+	while ( i < 100 ) /* MAGIC */
+	{
+		TEST_ERR_IF( trotListInit( testProgram, &lSlabTwin ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( trotListAppendList( testProgram, lSlab, lSlabTwin ) != TROT_RC_SUCCESS );
+		trotListFree( testProgram, &lSlabTwin );
+		TEST_ERR_IF( trotListRemove( testProgram, lSlab, 1 ) != TROT_RC_SUCCESS );
+
+		/* after the first time, everything should come from the slabs we have */
+		if ( i == 0 )
+		{
+			TEST_ERR_IF( trotProgramMemoryGetSlabStats( testProgram, &slabs, &slabBytes, &slabObjects ) != TROT_RC_SUCCESS );
+		}
+
+		i += 1;
+	}
+
+	TEST_ERR_IF( trotProgramMemoryGetSlabStats( testProgram, &slabs2, &slabBytes2, &slabObjects2 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( slabs2 != slabs );
+	TEST_ERR_IF( slabBytes2 != slabBytes );
+	TEST_ERR_IF( slabObjects2 != slabObjects );
+
+	trotListFree( testProgram, &lSlab );
+
+	TEST_ERR_IF( trotProgramMemoryGetSlabStats( testProgram, &slabs, &slabBytes, &slabObjects ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( slabs != slabs2 );
+	TEST_ERR_IF( slabObjects != 0 );
+
+	trotProgramFree( &testProgram );
+
+	/* **************************************** */
+	/* test that freeing a program frees everything, even lists that are still
+	   held and lists in cycles */
+	printf( "  Testing freeing a program...\n" ); fflush( stdout );
+	mallocsBefore = outstandingMallocs;
+
+	TEST_ERR_IF( ( testProgram = TROT_HOOK_CALLOC( 1, sizeof( *program ) ) ) == NULL );
+	TEST_ERR_IF( trotProgramMemorySetLimit( testProgram, TROT_INT_MAX ) != TROT_RC_SUCCESS );
+
+	TEST_ERR_IF( trotListInit( testProgram, &lTeardown ) != TROT_RC_SUCCESS );
+
+	i = 0;
+	while ( i < 1000 ) /* MAGIC */
+	{
+		TEST_ERR_IF( trotListAppendInt( testProgram, lTeardown, i ) != TROT_RC_SUCCESS );
+
+		if ( i % 100 == 0 ) /* MAGIC */
+		{
+			TEST_ERR_IF( trotListAppendList( testProgram, lTeardown, lTeardown ) != TROT_RC_SUCCESS );
+		}
+
+		i += 1;
+	}
+
+	TEST_ERR_IF( testProgram->bigBlocks == NULL );
+
+	trotProgramFree( &testProgram );
+	TEST_ERR_IF( testProgram != NULL );
+	TEST_ERR_IF( outstandingMallocs != mallocsBefore );
+
+	/* lTeardown was freed with the program */
+	lTeardown = NULL;
+
+	/* **************************************** */
+	/* test that a program given an allocator gets all its memory from it */
+	printf( "  Testing a program's allocator...\n" ); fflush( stdout );
+	mallocsBefore = outstandingMallocs;
+
+	allocator.mallocFunc = countingMalloc;
+	allocator.callocFunc = countingCalloc;
+	allocator.reallocFunc = countingRealloc;
+	allocator.freeFunc = countingFree;
+	allocator.context = &counting;
+
+	TEST_ERR_IF( trotProgramLoad( TROT_INT_MAX, &allocator, "", &testProgram ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( counting.outstanding != 1 );
+
+	TEST_ERR_IF( trotListInit( testProgram, &lTeardown ) != TROT_RC_SUCCESS );
+
+	/* enough lists that the encoder has to grow its table */
+	i = 0;
+	while ( i < 300 ) /* MAGIC */
+	{
+		TEST_ERR_IF( trotListInit( testProgram, &lChild ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( trotListAppendInt( testProgram, lChild, i ) != TROT_RC_SUCCESS );
+		TEST_ERR_IF( trotListAppendList( testProgram, lTeardown, lChild ) != TROT_RC_SUCCESS );
+		trotListFree( testProgram, &lChild );
+
+		i += 1;
+	}
+
+	TEST_ERR_IF( trotEncode( testProgram, lTeardown, &lCharacters ) != TROT_RC_SUCCESS );
+
+	TEST_ERR_IF( counting.reallocs == 0 );
+	TEST_ERR_IF( outstandingMallocs != mallocsBefore );
+
+	trotListFree( testProgram, &lCharacters );
+	trotListFree( testProgram, &lTeardown );
+
+	trotProgramFree( &testProgram );
+	TEST_ERR_IF( counting.outstanding != 0 );
+	TEST_ERR_IF( outstandingMallocs != mallocsBefore );
+
 	/* **************************************** */
 	/* test memory management */
 	printf( "  Testing garbage collection...\n" ); fflush( stdout );
@@ -291,6 +494,314 @@ int testMemory( TrotProgram *program )
 
 	printf( "\n" ); fflush( stdout );
 
+	/* **************************************** */
+	/* test collecting garbage in batches */
+	printf( "  Testing deferred garbage collection...\n" ); fflush( stdout );
+	TEST_ERR_IF( trotProgramLoad( TROT_INT_MAX, NULL, "", &testProgram ) != TROT_RC_SUCCESS );
+
+	/* lists made before deferring wouldn't be found by the collector */
+	TEST_ERR_IF( trotListInit( testProgram, &lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramGcSetMode( testProgram, TROT_GC_DEFERRED ) != TROT_RC_ERROR_PRECOND );
+	trotListFree( testProgram, &lTeardown );
+
+	TEST_ERR_IF( trotProgramGcSetMode( testProgram, TROT_GC_DEFERRED ) != TROT_RC_SUCCESS );
+
+	/* a list that holds itself and another list */
+	TEST_ERR_IF( trotListInit( testProgram, &lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( testProgram, &lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInt( testProgram, lChild, 7 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lTeardown, lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lTeardown, lTeardown ) != TROT_RC_SUCCESS );
+	trotListFree( testProgram, &lChild );
+
+	/* lChild is still held by lTeardown, so it has to survive */
+	TEST_ERR_IF( trotProgramGcCollect( testProgram ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( testProgram, lTeardown ) != 0 );
+	TEST_ERR_IF( trotListGetList( testProgram, lTeardown, 1, &lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( check( testProgram, lChild, 1, 7 ) != 0 );
+	trotListFree( testProgram, &lChild );
+
+	/* freeing the last client ref doesn't free anything until we collect */
+	TEST_ERR_IF( trotProgramMemoryGetUsed( testProgram, &memUsed ) != TROT_RC_SUCCESS );
+	trotListFree( testProgram, &lTeardown );
+	TEST_ERR_IF( testProgram->memoryUsed != memUsed );
+
+	TEST_ERR_IF( trotProgramGcCollect( testProgram ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( testProgram, &memUsed ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memUsed != 0 );
+
+	/* the same random lists as above, collecting now and then */
+	i = 0;
+	while ( i < 20 ) /* MAGIC */
+	{
+		TEST_ERR_IF( testMemoryManagement( testProgram ) != 0 );
+
+		if ( i % 5 == 0 ) /* MAGIC */
+		{
+			TEST_ERR_IF( trotProgramGcCollect( testProgram ) != TROT_RC_SUCCESS );
+		}
+
+		i += 1;
+	}
+
+	/* finish any collection the steps above started */
+	TEST_ERR_IF( trotProgramGcCollect( testProgram ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( testProgram->gcPhase != GC_PHASE_IDLE );
+
+	/* a step with a tiny budget does at least a little work */
+	TEST_ERR_IF( trotProgramGcSetBudget( testProgram, 0 ) != TROT_RC_ERROR_PRECOND );
+	TEST_ERR_IF( trotProgramGcSetBudget( testProgram, 1 ) != TROT_RC_SUCCESS );
+
+	/* a list given back to the client after the collector has looked at it
+	   has to survive. the newest list is first in the heap, so the collector
+	   looks at lChild before lTeardown. */
+	TEST_ERR_IF( trotListInit( testProgram, &lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( testProgram, &lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInt( testProgram, lChild, 7 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lTeardown, lChild ) != TROT_RC_SUCCESS );
+	trotListFree( testProgram, &lChild );
+
+	TEST_ERR_IF( trotProgramGcStep( testProgram, &finished ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( finished != 0 );
+	TEST_ERR_IF( testProgram->gcCursor != lTeardown->laPointsTo );
+
+	TEST_ERR_IF( trotListRemoveList( testProgram, lTeardown, 1, &lChild ) != TROT_RC_SUCCESS );
+
+	while ( finished == 0 )
+	{
+		TEST_ERR_IF( trotProgramGcStep( testProgram, &finished ) != TROT_RC_SUCCESS );
+	}
+
+	TEST_ERR_IF( check( testProgram, lChild, 1, 7 ) != 0 );
+	trotListFree( testProgram, &lChild );
+	trotListFree( testProgram, &lTeardown );
+
+	/* lists moved into a list the collector has already scanned have to
+	   survive too. lTeardown is older than lOther, so it's scanned first. */
+	TEST_ERR_IF( trotListInit( testProgram, &lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( testProgram, &lOther ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( testProgram, &lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInt( testProgram, lChild, 7 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lOther, lChild ) != TROT_RC_SUCCESS );
+	trotListFree( testProgram, &lChild );
+
+	/* the step that finishes looking for client refs scans lTeardown */
+	finished = 0;
+	while ( testProgram->gcPhase != GC_PHASE_MARK )
+	{
+		TEST_ERR_IF( trotProgramGcStep( testProgram, &finished ) != TROT_RC_SUCCESS );
+	}
+	TEST_ERR_IF( testProgram->gcStack != lOther->laPointsTo );
+
+	TEST_ERR_IF( trotListConcat( testProgram, lTeardown, lOther ) != TROT_RC_SUCCESS );
+	trotListFree( testProgram, &lOther );
+
+	while ( finished == 0 )
+	{
+		TEST_ERR_IF( trotProgramGcStep( testProgram, &finished ) != TROT_RC_SUCCESS );
+	}
+
+	TEST_ERR_IF( checkList( testProgram, lTeardown ) != 0 );
+	TEST_ERR_IF( trotListGetList( testProgram, lTeardown, 1, &lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( check( testProgram, lChild, 1, 7 ) != 0 );
+	trotListFree( testProgram, &lChild );
+
+	/* the same random lists, collecting a little at a time */
+	TEST_ERR_IF( trotProgramGcSetBudget( testProgram, 3 ) != TROT_RC_SUCCESS );
+	i = 0;
+	while ( i < 5 ) /* MAGIC */
+	{
+		TEST_ERR_IF( testMemoryManagement( testProgram ) != 0 );
+
+		i += 1;
+	}
+
+	/* leave a collection under way */
+	trotListFree( testProgram, &lTeardown );
+	TEST_ERR_IF( trotProgramGcStep( testProgram, &finished ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( testProgram->gcPhase == GC_PHASE_IDLE );
+
+	/* going back to freeing lists right away collects what's left */
+	TEST_ERR_IF( trotProgramGcSetMode( testProgram, TROT_GC_IMMEDIATE ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( testProgram, &memUsed ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memUsed != 0 );
+
+	trotProgramFree( &testProgram );
+
+	/* **************************************** */
+	/* test counting refs and collecting cycles */
+	printf( "  Testing cycle collection...\n" ); fflush( stdout );
+	TEST_ERR_IF( trotProgramLoad( TROT_INT_MAX, NULL, "", &testProgram ) != TROT_RC_SUCCESS );
+
+	TEST_ERR_IF( trotProgramGcSetMode( testProgram, 3 ) != TROT_RC_ERROR_PRECOND );
+	TEST_ERR_IF( trotProgramGcSetMode( testProgram, TROT_GC_CYCLES ) != TROT_RC_SUCCESS );
+
+	/* lists nothing refers to are freed right away */
+	TEST_ERR_IF( trotListInit( testProgram, &lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( testProgram, &lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lTeardown, lChild ) != TROT_RC_SUCCESS );
+	trotListFree( testProgram, &lTeardown );
+	trotListFree( testProgram, &lChild );
+
+	TEST_ERR_IF( trotProgramMemoryGetUsed( testProgram, &memUsed ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memUsed != 0 );
+	TEST_ERR_IF( testProgram->gcRootsCount != 0 );
+
+	/* a list that holds itself waits for the cycle collector */
+	TEST_ERR_IF( trotListInit( testProgram, &lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lTeardown, lTeardown ) != TROT_RC_SUCCESS );
+	trotListFree( testProgram, &lTeardown );
+
+	TEST_ERR_IF( testProgram->memoryUsed == 0 );
+	TEST_ERR_IF( testProgram->gcRootsCount != 1 );
+
+	TEST_ERR_IF( trotProgramGcCollect( testProgram ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( testProgram, &memUsed ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memUsed != 0 );
+	TEST_ERR_IF( testProgram->gcRootsCount != 0 );
+
+	/* a garbage cycle can hold a list that isn't garbage */
+	TEST_ERR_IF( trotListInit( testProgram, &lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( testProgram, &lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lTeardown, lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lTeardown, lChild ) != TROT_RC_SUCCESS );
+	trotListFree( testProgram, &lTeardown );
+
+	TEST_ERR_IF( trotProgramGcCollect( testProgram ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( testProgram, lChild ) != 0 );
+	TEST_ERR_IF( lChild->laPointsTo->refList != lChild );
+	TEST_ERR_IF( lChild->refNext != NULL );
+	trotListFree( testProgram, &lChild );
+
+	TEST_ERR_IF( trotProgramMemoryGetUsed( testProgram, &memUsed ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memUsed != 0 );
+
+	/* a cycle that's still held by another list survives */
+	TEST_ERR_IF( trotListInit( testProgram, &lOther ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( testProgram, &lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( testProgram, &lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendInt( testProgram, lChild, 7 ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lTeardown, lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lChild, lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lOther, lTeardown ) != TROT_RC_SUCCESS );
+	trotListFree( testProgram, &lTeardown );
+	trotListFree( testProgram, &lChild );
+
+	TEST_ERR_IF( trotProgramGcCollect( testProgram ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( testProgram, lOther ) != 0 );
+	TEST_ERR_IF( trotListGetList( testProgram, lOther, 1, &lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListGetList( testProgram, lTeardown, 1, &lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( testProgram, lChild ) != 0 );
+	TEST_ERR_IF( check( testProgram, lChild, 1, 7 ) != 0 );
+	trotListFree( testProgram, &lTeardown );
+	trotListFree( testProgram, &lChild );
+
+	/* once nothing holds it, it's garbage */
+	trotListFree( testProgram, &lOther );
+	TEST_ERR_IF( trotProgramGcCollect( testProgram ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( testProgram, &memUsed ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memUsed != 0 );
+
+	/* the same random lists as above, collecting cycles now and then */
+	i = 0;
+	while ( i < 20 ) /* MAGIC */
+	{
+		TEST_ERR_IF( testMemoryManagement( testProgram ) != 0 );
+
+		if ( i % 5 == 0 ) /* MAGIC */
+		{
+			TEST_ERR_IF( trotProgramGcCollect( testProgram ) != TROT_RC_SUCCESS );
+		}
+
+		i += 1;
+	}
+
+	TEST_ERR_IF( testDeepList( testProgram ) != 0 );
+
+	/* going back to freeing lists right away frees any cycles left */
+	TEST_ERR_IF( trotProgramGcSetMode( testProgram, TROT_GC_IMMEDIATE ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( testProgram, &memUsed ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memUsed != 0 );
+
+	/* lists made while deferring can end up in a cycle after the heap they
+	   were on is gone */
+	TEST_ERR_IF( trotProgramGcSetMode( testProgram, TROT_GC_DEFERRED ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( testProgram, &lTeardown ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( testProgram, &lOther ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramGcSetMode( testProgram, TROT_GC_IMMEDIATE ) != TROT_RC_SUCCESS );
+	trotListFree( testProgram, &lTeardown );
+
+	TEST_ERR_IF( trotProgramGcSetMode( testProgram, TROT_GC_CYCLES ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListInit( testProgram, &lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lOther, lChild ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotListAppendList( testProgram, lChild, lOther ) != TROT_RC_SUCCESS );
+	trotListFree( testProgram, &lChild );
+
+	TEST_ERR_IF( trotProgramGcCollect( testProgram ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( checkList( testProgram, lOther ) != 0 );
+	trotListFree( testProgram, &lOther );
+
+	TEST_ERR_IF( trotProgramGcCollect( testProgram ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( testProgram, &memUsed ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memUsed != 0 );
+
+	trotProgramFree( &testProgram );
+
+	/* **************************************** */
+	/* refs come out of the middle of a list's refList too */
+	printf( "  Testing many refs to one list...\n" ); fflush( stdout );
+	TEST_ERR_IF( trotProgramLoad( TROT_INT_MAX, NULL, "", &testProgram ) != TROT_RC_SUCCESS );
+
+	lShared[ 0 ] = NULL;
+	TEST_ERR_IF( trotListInit( testProgram, &( lShared[ 0 ] ) ) != TROT_RC_SUCCESS );
+	i = 1;
+	while ( i < SHARED_REFS_COUNT )
+	{
+		lShared[ i ] = NULL;
+		TEST_ERR_IF( trotListTwin( testProgram, lShared[ 0 ], &( lShared[ i ] ) ) != TROT_RC_SUCCESS );
+
+		i += 1;
+	}
+
+	/* free them in a random order */
+	i = 0;
+	while ( i < SHARED_REFS_COUNT - 1 )
+	{
+		j = rand() % SHARED_REFS_COUNT;
+		while ( lShared[ j ] == NULL )
+		{
+			j = ( j + 1 ) % SHARED_REFS_COUNT;
+		}
+
+		trotListFree( testProgram, &( lShared[ j ] ) );
+
+		j = ( j + 1 ) % SHARED_REFS_COUNT;
+		while ( lShared[ j ] == NULL )
+		{
+			j = ( j + 1 ) % SHARED_REFS_COUNT;
+		}
+
+		TEST_ERR_IF( checkList( testProgram, lShared[ j ] ) != 0 );
+
+		refs = 0;
+		lRef = lShared[ j ]->laPointsTo->refList;
+		while ( lRef != NULL )
+		{
+			refs += 1;
+			lRef = lRef->refNext;
+		}
+
+		TEST_ERR_IF( refs != SHARED_REFS_COUNT - 1 - i );
+
+		i += 1;
+	}
+
+	trotListFree( testProgram, &( lShared[ j ] ) );
+	TEST_ERR_IF( trotProgramMemoryGetUsed( testProgram, &memUsed ) != TROT_RC_SUCCESS );
+	TEST_ERR_IF( memUsed != 0 );
+
+	trotProgramFree( &testProgram );
+
 	/* **************************************** */
 	/* *** */
 	printf( "  Testing a \"deep list\"...\n" ); fflush( stdout );
@@ -332,6 +843,8 @@ static int testMemoryManagement( TrotProgram *program )
 	int countAdded = 0;
 	int howManyToRemove = 0;
 
+	TROT_INT finished = 0;
+
 
 	/* CODE */
 	/* create our client refs */
@@ -399,10 +912,17 @@ static int testMemoryManagement( TrotProgram *program )
 		/* free our temporary ref */
 		trotListFree( program, &ref );
 
+		/* if the program collects garbage a little at a time, do a step */
+		TEST_ERR_IF( trotProgramGcStep( program, &finished ) != TROT_RC_SUCCESS );
+
 		/* *** */
 		i += 1;
 	}
 
+	/* if the program collects garbage in batches, collect while the client
+	   refs are still holding lists */
+	TEST_ERR_IF( trotProgramGcCollect( program ) != TROT_RC_SUCCESS );
+
 	/* remove random lists */
 	howManyToRemove = rand() % countAdded;
 
@@ -432,10 +952,21 @@ static int testMemoryManagement( TrotProgram *program )
 			}
 		}
 
+		TEST_ERR_IF( trotProgramGcStep( program, &finished ) != TROT_RC_SUCCESS );
+
 		/* *** */
 		i += 1;
 	}
 
+	/* anything the collector freed too soon would show up here */
+	i = 0;
+	while ( i < MEMORY_MANAGEMENT_REFS_COUNT )
+	{
+		TEST_ERR_IF( checkList( program, clientRefs[ i ] ) != 0 );
+
+		i += 1;
+	}
+
 	/* free our client refs */
 	i = 0;
 	while ( i < MEMORY_MANAGEMENT_REFS_COUNT )
@@ -539,6 +1070,8 @@ static TROT_RC testFailedMallocs1( TrotProgram *program, int test )
 	TrotList *l2 = NULL;
 	TrotList *l3 = NULL;
 
+	TROT_INT ints[ ( TROT_NODE_SIZE * 3 ) + 1 ];
+
 
 	/* CODE */
 	(void)test;
@@ -714,6 +1247,77 @@ static TROT_RC testFailedMallocs1( TrotProgram *program, int test )
 	trotListFree( program, &l1 );
 	trotListFree( program, &l2 );
 
+	/* bulk ints */
+	i = 0;
+	while ( i < ( TROT_NODE_SIZE * 3 ) + 1 )
+	{
+		ints[ i ] = i;
+
+		i += 1;
+	}
+
+	rc = trotListInit( program, &l1 );
+	ERR_IF_PASSTHROUGH;
+	rc = trotListInit( program, &l2 );
+	ERR_IF_PASSTHROUGH;
+
+	rc = trotListAppendInts( program, l1, ints, 2 );
+	ERR_IF_PASSTHROUGH;
+	rc = trotListAppendInts( program, l1, ints, ( TROT_NODE_SIZE * 3 ) + 1 );
+	ERR_IF_PASSTHROUGH;
+	rc = trotListInsertInts( program, l1, 2, ints, ( TROT_NODE_SIZE * 3 ) + 1 );
+	ERR_IF_PASSTHROUGH;
+	rc = trotListAppendList( program, l1, l2 );
+	ERR_IF_PASSTHROUGH;
+	rc = trotListInsertInts( program, l1, -2, ints, ( TROT_NODE_SIZE * 3 ) + 1 );
+	ERR_IF_PASSTHROUGH;
+
+	/* ranges */
+	i = 0;
+	while ( i < TROT_NODE_SIZE + 2 )
+	{
+		rc = trotListInsertList( program, l1, TROT_NODE_SIZE, l2 );
+		ERR_IF_PASSTHROUGH;
+
+		i += 1;
+	}
+
+	rc = trotListSlice( program, l1, 2, -2, &l3 );
+	ERR_IF_PASSTHROUGH;
+	rc = trotListReplaceRange( program, l1, 3, TROT_NODE_SIZE * 2, l3 );
+	ERR_IF_PASSTHROUGH;
+	trotListFree( program, &l3 );
+	rc = trotListReplaceRange( program, l1, -TROT_NODE_SIZE, -2, l1 );
+	ERR_IF_PASSTHROUGH;
+	rc = trotListRemoveRange( program, l1, TROT_NODE_SIZE, TROT_NODE_SIZE * 3 );
+	ERR_IF_PASSTHROUGH;
+
+	/* concat and split */
+	rc = trotListSplitAt( program, l1, TROT_NODE_SIZE + 1, &l3 );
+	ERR_IF_PASSTHROUGH;
+	rc = trotListConcat( program, l3, l1 );
+	ERR_IF_PASSTHROUGH;
+	rc = trotListConcat( program, l1, l3 );
+	ERR_IF_PASSTHROUGH;
+	trotListFree( program, &l3 );
+
+	i = 0;
+	while ( i < ( TROT_NODE_SIZE * 3 ) + 1 )
+	{
+		rc = trotListSplitAt( program, l1, -2, &l3 );
+		ERR_IF_PASSTHROUGH;
+		rc = trotListConcat( program, l3, l1 );
+		ERR_IF_PASSTHROUGH;
+		trotListFree( program, &l1 );
+		l1 = l3;
+		l3 = NULL;
+
+		i += 1;
+	}
+
+	trotListFree( program, &l1 );
+	trotListFree( program, &l2 );
+
 
 	/* CLEANUP */
 	cleanup:
@@ -810,3 +1414,36 @@ static TROT_RC testFailedMallocs2( TrotProgram *program, int test )
 	return rc;
 }
 
+
+/******************************************************************************/
+static void *countingMalloc( void *context, size_t size )
+{
+	( (CountingAllocator *)context )->outstanding += 1;
+
+	return malloc( size );
+}
+
+/******************************************************************************/
+static void *countingCalloc( void *context, size_t nmemb, size_t size )
+{
+	( (CountingAllocator *)context )->outstanding += 1;
+
+	return calloc( nmemb, size );
+}
+
+/******************************************************************************/
+static void *countingRealloc( void *context, void *p, size_t size )
+{
+	( (CountingAllocator *)context )->reallocs += 1;
+
+	return realloc( p, size );
+}
+
+/******************************************************************************/
+static void countingFree( void *context, void *p )
+{
+	( (CountingAllocator *)context )->outstanding -= 1;
+
+	free( p );
+}
+
@@ -28,6 +28,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 /******************************************************************************/
+#include <stddef.h> /* offsetof */
 #include <string.h> /* strcmp */
 
 #include "trot.h"
@@ -78,6 +79,23 @@ int testMisc( TrotProgram *program )
 	string = trotRCToString( -2 );
 	TEST_ERR_IF( strcmp( string, "Unknown Error" ) != 0 );
 
+	/* make sure lists don't get bigger. everything before headNode is
+	   overhead that every list has, whatever is in it */
+	TEST_ERR_IF( offsetof( TrotListActual, headNode ) > ( 6 * sizeof( void * ) ) + ( 6 * sizeof( TROT_INT ) ) );
+	TEST_ERR_IF( sizeof( TrotListActual ) >
+	                offsetof( TrotListActual, headNode )
+	              + ( 2 * sizeof( TrotListNode ) )
+	              + sizeof( TrotList )
+	              + ( TROT_LIST_INLINE * sizeof( TrotList * ) )
+	              + sizeof( void * )
+	           );
+
+	/* same for nodes, which are all header before their items */
+	TEST_ERR_IF( sizeof( TrotListNode ) > ( 2 * sizeof( void * ) ) + ( 4 * sizeof( TROT_INT ) ) );
+
+	/* a node's items are right after it, even for the inline node */
+	TEST_ERR_IF( offsetof( TrotListActual, inlineItems ) != offsetof( TrotListActual, inlineNode ) + sizeof( TrotListNode ) );
+
 	printf( "\n" );
 
 